@@ -1,37 +1,467 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
 #include <cstdlib>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <vector>
 #include <random>
+#include <sstream>
 #include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
 #include <iostream>
+#include <chrono>
 
-template<typename T>
+/**
+ * Small, fast engines for RandomQueue. All three model the standard
+ * UniformRandomBitGenerator concept, so they also work with <random>
+ * distributions, and all are seeded from a single 64-bit value. Like the
+ * standard engines they support discard(), == and stream insertion and
+ * extraction of their state, and each has a cheap way to split off
+ * independent streams for parallel work: see makeStreams().
+ */
+
+// splitmix64: one word of state. Good on its own and used to expand a
+// single seed into the state of the other engines.
+class SplitMix64 {
+public:
+    using result_type = uint64_t;
+
+    explicit SplitMix64(uint64_t seed = 0) : state(seed) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    result_type operator()() {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    // The state is a Weyl sequence, so skipping ahead is one multiply.
+    void discard(uint64_t n) {
+        state += n * 0x9e3779b97f4a7c15ULL;
+    }
+
+    bool operator==(const SplitMix64& o) const { return state == o.state; }
+    bool operator!=(const SplitMix64& o) const { return !(*this == o); }
+
+    friend std::ostream& operator<<(std::ostream& os, const SplitMix64& g) {
+        return os << g.state;
+    }
+
+    friend std::istream& operator>>(std::istream& is, SplitMix64& g) {
+        return is >> g.state;
+    }
+
+private:
+    uint64_t state;
+};
+
+// xoshiro256**: 32 bytes of state, period 2^256 - 1.
+class Xoshiro256StarStar {
+public:
+    using result_type = uint64_t;
+
+    explicit Xoshiro256StarStar(uint64_t seed = 0) {
+        SplitMix64 expand(seed);
+        for (uint64_t& word : s) word = expand();
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    result_type operator()() {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // Equivalent to 2^128 calls: splits the period into 2^128
+    // non-overlapping streams, one per parallel worker.
+    void jump() {
+        static const uint64_t poly[] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                        0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+        applyJump(poly);
+    }
+
+    // Equivalent to 2^192 calls: 2^64 starting points, each with room for
+    // 2^64 jump() streams.
+    void long_jump() {
+        static const uint64_t poly[] = {0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL,
+                                        0x77710069854ee241ULL, 0x39109bb02acbe635ULL};
+        applyJump(poly);
+    }
+
+    void discard(uint64_t n) {
+        for (; n > 0; --n) (*this)();
+    }
+
+    bool operator==(const Xoshiro256StarStar& o) const {
+        return std::equal(std::begin(s), std::end(s), std::begin(o.s));
+    }
+    bool operator!=(const Xoshiro256StarStar& o) const { return !(*this == o); }
+
+    friend std::ostream& operator<<(std::ostream& os, const Xoshiro256StarStar& g) {
+        return os << g.s[0] << ' ' << g.s[1] << ' ' << g.s[2] << ' ' << g.s[3];
+    }
+
+    friend std::istream& operator>>(std::istream& is, Xoshiro256StarStar& g) {
+        return is >> g.s[0] >> g.s[1] >> g.s[2] >> g.s[3];
+    }
+
+private:
+    uint64_t s[4];
+
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    void applyJump(const uint64_t (&poly)[4]) {
+        uint64_t t[4] = {0, 0, 0, 0};
+        for (uint64_t word : poly) {
+            for (int b = 0; b < 64; ++b) {
+                if (word & (1ULL << b)) {
+                    for (int k = 0; k < 4; ++k) t[k] ^= s[k];
+                }
+                (*this)();
+            }
+        }
+        std::copy(std::begin(t), std::end(t), std::begin(s));
+    }
+};
+
+// PCG32 (XSH-RR): 16 bytes of state, 32-bit output.
+class Pcg32 {
+public:
+    using result_type = uint32_t;
+
+    explicit Pcg32(uint64_t seed = 0x853c49e6748fea9bULL, uint64_t stream = 0xda3e39cb94b95bdbULL)
+        : state(0), inc((stream << 1) | 1) {
+        (*this)();
+        state += seed;
+        (*this)();
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT32_MAX; }
+
+    result_type operator()() {
+        uint64_t old = state;
+        state = old * 6364136223846793005ULL + inc;
+        uint32_t xorshifted = static_cast<uint32_t>(((old >> 18) ^ old) >> 27);
+        uint32_t rot = static_cast<uint32_t>(old >> 59);
+        return (xorshifted >> rot) | (xorshifted << ((~rot + 1) & 31));
+    }
+
+    // Skips delta outputs in O(log delta) by composing the LCG step with
+    // itself (Brown, "Random number generation with arbitrary strides").
+    void advance(uint64_t delta) {
+        uint64_t curMult = 6364136223846793005ULL, curPlus = inc;
+        uint64_t accMult = 1, accPlus = 0;
+        for (; delta > 0; delta >>= 1) {
+            if (delta & 1) {
+                accMult *= curMult;
+                accPlus = accPlus * curMult + curPlus;
+            }
+            curPlus = (curMult + 1) * curPlus;
+            curMult *= curMult;
+        }
+        state = accMult * state + accPlus;
+    }
+
+    void discard(uint64_t n) {
+        advance(n);
+    }
+
+    bool operator==(const Pcg32& o) const { return state == o.state && inc == o.inc; }
+    bool operator!=(const Pcg32& o) const { return !(*this == o); }
+
+    friend std::ostream& operator<<(std::ostream& os, const Pcg32& g) {
+        return os << g.state << ' ' << g.inc;
+    }
+
+    friend std::istream& operator>>(std::istream& is, Pcg32& g) {
+        return is >> g.state >> g.inc;
+    }
+
+private:
+    uint64_t state;
+    uint64_t inc;
+};
+
+// count engines for parallel workers, all derived from one seed so runs
+// are reproducible. Xoshiro256StarStar streams are jump() apart, Pcg32
+// streams use distinct increments (separate sequences, not offsets into
+// one), and any other engine is seeded with successive splitmix64 outputs.
+template<typename RNG>
+std::vector<RNG> makeStreams(uint64_t seed, size_t count) {
+    std::vector<RNG> streams;
+    streams.reserve(count);
+    if constexpr (std::is_same<RNG, Xoshiro256StarStar>::value) {
+        RNG g(seed);
+        for (size_t i = 0; i < count; ++i) {
+            streams.push_back(g);
+            g.jump();
+        }
+    } else if constexpr (std::is_same<RNG, Pcg32>::value) {
+        for (size_t i = 0; i < count; ++i) {
+            streams.emplace_back(seed, i);
+        }
+    } else {
+        SplitMix64 expand(seed);
+        for (size_t i = 0; i < count; ++i) {
+            streams.emplace_back(expand());
+        }
+    }
+    return streams;
+}
+
+// 32 uniform bits from any engine: full 32-bit engines are used as is,
+// full 64-bit engines give their high half, anything else goes through
+// the standard distribution.
+template<typename URBG>
+uint32_t random32(URBG& g) {
+    constexpr auto span = URBG::max() - URBG::min();
+    if constexpr (span == UINT32_MAX) {
+        return static_cast<uint32_t>(g() - URBG::min());
+    } else if constexpr (span == UINT64_MAX) {
+        return static_cast<uint32_t>(g() >> 32);
+    } else {
+        return std::uniform_int_distribution<uint32_t>()(g);
+    }
+}
+
+// Uniform integer in [0, range) by Lemire's nearly divisionless method:
+// the high half of random32() * range, with a division only on the rare
+// path where the low half lands in the biased zone.
+template<typename URBG>
+size_t boundedRandom(URBG& g, size_t range) {
+    if (range > UINT32_MAX) {
+        return std::uniform_int_distribution<size_t>(0, range - 1)(g);
+    }
+    uint32_t r = static_cast<uint32_t>(range);
+    uint64_t m = static_cast<uint64_t>(random32(g)) * r;
+    uint32_t low = static_cast<uint32_t>(m);
+    if (low < r) {
+        uint32_t threshold = (0u - r) % r;
+        while (low < threshold) {
+            m = static_cast<uint64_t>(random32(g)) * r;
+            low = static_cast<uint32_t>(m);
+        }
+    }
+    return static_cast<size_t>(m >> 32);
+}
+
+template<typename T, typename RNG = std::mt19937>
 class RandomQueue {
 private:
     std::vector<T> data;
-    std::mt19937 rng;
+    // Drawing a random number does not change the queue's contents, so
+    // peek() and the other read-only samplers stay const.
+    mutable RNG rng;
+
+    // Reservoir mode (capacity != 0). Algorithm L: w is the largest key in
+    // the reservoir, and the stream index of the next accepted item is
+    // drawn up front, so skipped items cost no RNG call.
+    size_t capacity = 0;
+    uint64_t seenCount = 0;
+    uint64_t nextAccept = 0;
+    double w = 0;
+
+    double uniformOpen() {   // uniform in (0, 1]
+        return 1.0 - std::generate_canonical<double, 53>(rng);
+    }
+
+    void scheduleNext() {
+        double skip = std::floor(std::log(uniformOpen()) / std::log1p(-w));
+        nextAccept = seenCount + (skip < 1e18 ? static_cast<uint64_t>(skip) : static_cast<uint64_t>(1e18));
+    }
+
+    // Called when the reservoir becomes full after seenCount items. The
+    // largest of the k smallest of seenCount uniform keys is distributed
+    // Beta(k, seenCount - k + 1), independently of which items they are.
+    void startSkipping() {
+        double x = std::gamma_distribution<double>(static_cast<double>(capacity))(rng);
+        double y = std::gamma_distribution<double>(static_cast<double>(seenCount - capacity + 1))(rng);
+        w = x / (x + y);
+        scheduleNext();
+    }
+
+    // Shared by add() and emplace(): make(slot) stores a new element,
+    // appending when slot is null. In reservoir mode it is not called at
+    // all for skipped items, so they are never constructed.
+    template<typename Make>
+    void offer(Make&& make) {
+        ++seenCount;
+        if (capacity == 0 || data.size() < capacity) {
+            make(nullptr);
+            if (data.size() == capacity) {
+                startSkipping();
+            }
+        } else if (seenCount - 1 == nextAccept) {
+            make(&data[boundedRandom(rng, capacity)]);
+            w *= std::exp(std::log(uniformOpen()) / capacity);
+            scheduleNext();
+        }
+    }
 
 public:
     RandomQueue() : rng(std::random_device{}()) {}
 
+    explicit RandomQueue(uint64_t seed) : rng(seed) {}
+
+    // Takes over an engine, e.g. one of makeStreams(), so that parallel
+    // workers each follow their own reproducible sequence.
+    explicit RandomQueue(const RNG& engine) : rng(engine) {}
+
+    void seed(uint64_t value) {
+        rng = RNG(value);
+    }
+
+    // Snapshot and restore of the RNG state, not of the contents: a queue
+    // restored to a snapshot and holding the same elements in the same
+    // order repeats the same removals. Engines can also be written to and
+    // read from streams with << and >>.
+    RNG snapshot() const {
+        return rng;
+    }
+
+    void restore(const RNG& state) {
+        rng = state;
+    }
+
     void add(const T& element) {
-        data.push_back(element);
+        offer([&](T* slot) {
+            if (slot) *slot = element;
+            else data.push_back(element);
+        });
+    }
+
+    void add(T&& element) {
+        offer([&](T* slot) {
+            if (slot) *slot = std::move(element);
+            else data.push_back(std::move(element));
+        });
+    }
+
+    // Constructs the element in place from args.
+    template<typename... Args>
+    void emplace(Args&&... args) {
+        offer([&](T* slot) {
+            if (slot) *slot = T(std::forward<Args>(args)...);
+            else data.emplace_back(std::forward<Args>(args)...);
+        });
+    }
+
+    // Adds [first, last). In reservoir mode with random-access iterators
+    // the skipped items are jumped over without being read.
+    template<typename It>
+    void addRange(It first, It last) {
+        using Category = typename std::iterator_traits<It>::iterator_category;
+        if constexpr (std::is_base_of<std::random_access_iterator_tag, Category>::value) {
+            while (first != last) {
+                if (capacity != 0 && data.size() == capacity) {
+                    uint64_t gap = nextAccept - seenCount;
+                    uint64_t remaining = static_cast<uint64_t>(last - first);
+                    if (gap >= remaining) {
+                        seenCount += remaining;
+                        return;
+                    }
+                    first += static_cast<typename std::iterator_traits<It>::difference_type>(gap);
+                    seenCount += gap;
+                }
+                add(*first);
+                ++first;
+            }
+        } else {
+            for (; first != last; ++first) {
+                add(*first);
+            }
+        }
+    }
+
+    // Bounds the queue to k elements and turns add() into reservoir
+    // sampling: after n adds the queue holds a uniform random k-subset of
+    // everything added. If the queue is already larger, a uniform k-subset
+    // of it is kept. k = 0 switches back to an unbounded queue. remove()
+    // still works, but the sample is only uniform while nothing has been
+    // removed.
+    void setCapacity(size_t k) {
+        capacity = k;
+        if (k == 0) {
+            return;
+        }
+        if (seenCount < data.size()) {
+            seenCount = data.size();
+        }
+        if (data.size() > k) {
+            std::vector<T> dropped;
+            removeMany(data.size() - k, dropped);
+        }
+        if (data.size() == k) {
+            startSkipping();
+        }
+    }
+
+    size_t getCapacity() const {
+        return capacity;
+    }
+
+    // Number of elements offered to add() so far, kept or not.
+    uint64_t seen() const {
+        return seenCount;
     }
 
     T remove() {
         if (empty()) {
             throw std::runtime_error("Cannot remove from empty queue");
         }
-        std::uniform_int_distribution<int> dist(0, data.size() - 1);
-        int randomIndex = dist(rng);
-        T result = data[randomIndex];
+        size_t randomIndex = boundedRandom(rng, data.size());
+        T result = std::move(data[randomIndex]);
 
+        // Fill the hole with the last element: one move, no swap.
         if (randomIndex != data.size() - 1) {
-            std::swap(data[randomIndex], data.back());
+            data[randomIndex] = std::move(data.back());
         }
         data.pop_back();
         return result;
     }
 
+    // Removes k random elements in one pass and appends them to out.
+    // A partial Fisher-Yates shuffle draws each pick from the shrinking
+    // prefix and swaps it into the tail, so the last k slots end up a
+    // uniform random sample that is moved out with one erase.
+    void removeMany(size_t k, std::vector<T>& out) {
+        if (k > data.size()) {
+            throw std::runtime_error("Cannot remove more elements than the queue holds");
+        }
+        size_t n = data.size();
+        for (size_t j = 0; j < k; ++j) {
+            size_t last = n - 1 - j;
+            size_t randomIndex = boundedRandom(rng, last + 1);
+            if (randomIndex != last) {
+                std::swap(data[randomIndex], data[last]);
+            }
+        }
+        out.insert(out.end(), std::make_move_iterator(data.end() - k),
+                   std::make_move_iterator(data.end()));
+        data.erase(data.end() - k, data.end());
+    }
+
     bool empty() const {
         return data.empty();
     }
@@ -44,13 +474,592 @@ public:
         if (empty()) {
             throw std::runtime_error("Cannot peek at empty queue");
         }
-        std::uniform_int_distribution<int> dist(0, data.size() - 1);
-        int randomIndex = dist(rng);
-        return data[randomIndex];
+        return data[boundedRandom(rng, data.size())];
+    }
+
+    // Returns k distinct random elements, in random order, without
+    // removing them. Runs the first k steps of a Fisher-Yates shuffle on
+    // a virtual index array; only displaced positions are stored, so a
+    // small sample of a large queue costs O(k) time and space.
+    std::vector<T> sample(size_t k) const {
+        if (k > data.size()) {
+            throw std::runtime_error("Cannot sample more elements than the queue holds");
+        }
+        std::vector<T> out;
+        out.reserve(k);
+        Shuffled order = shuffled();
+        for (auto it = order.begin(); out.size() < k; ++it) {
+            out.push_back(*it);
+        }
+        return out;
+    }
+
+    /**
+     * A single-pass view of the queue in uniformly random order. Each step
+     * of the iteration is one step of Fisher-Yates on a virtual index
+     * array, kept as a sparse map of displaced positions, so reading the
+     * first m elements costs O(m) and nothing is copied. The view has its
+     * own RNG, seeded from the queue's, and refers to the queue's storage:
+     * it is invalidated by add() and remove().
+     */
+    class Shuffled {
+    private:
+        const std::vector<T>* data;
+        RNG rng;
+        std::unordered_map<size_t, size_t> displaced;
+        size_t pos = 0;
+        size_t current = 0;
+
+        size_t indexAt(size_t i) const {
+            auto it = displaced.find(i);
+            return it == displaced.end() ? i : it->second;
+        }
+
+        void draw() {
+            size_t n = data->size();
+            if (pos >= n) {
+                return;
+            }
+            size_t r = pos + boundedRandom(rng, n - pos);
+            current = indexAt(r);
+            if (r != pos) {
+                displaced[r] = indexAt(pos);
+            }
+            displaced.erase(pos);
+        }
+
+    public:
+        Shuffled(const std::vector<T>& data, uint64_t seed) : data(&data), rng(seed) {}
+
+        class iterator {
+        private:
+            Shuffled* owner;
+            size_t pos;
+
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T*;
+            using reference = const T&;
+
+            iterator(Shuffled* owner, size_t pos) : owner(owner), pos(pos) {}
+
+            reference operator*() const { return (*owner->data)[owner->current]; }
+            pointer operator->() const { return &**this; }
+
+            iterator& operator++() {
+                ++pos;
+                ++owner->pos;
+                owner->draw();
+                return *this;
+            }
+
+            bool operator==(const iterator& other) const { return pos == other.pos; }
+            bool operator!=(const iterator& other) const { return pos != other.pos; }
+        };
+
+        // Can be called once per view.
+        iterator begin() {
+            draw();
+            return iterator(this, pos);
+        }
+
+        iterator end() {
+            return iterator(this, data->size());
+        }
+
+        size_t size() const {
+            return data->size();
+        }
+    };
+
+    Shuffled shuffled() const {
+        return Shuffled(data, (static_cast<uint64_t>(random32(rng)) << 32) | random32(rng));
+    }
+};
+
+
+/**
+ * A random queue whose remove() picks each element with probability
+ * proportional to its weight. Elements live in fixed slots so that add()
+ * can hand back a stable id for update_weight(); removed slots go on a
+ * free list. The weights sit in a Fenwick tree, so sampling is a single
+ * O(log n) descent and every update is O(log n).
+ */
+template<typename T, typename RNG = std::mt19937>
+class WeightedRandomQueue {
+private:
+    std::vector<T> items;
+    std::vector<double> weights;   // 0 for free slots
+    std::vector<double> tree;      // 1-based Fenwick tree over weights
+    std::vector<char> live;
+    std::vector<size_t> freeSlots;
+    size_t count = 0;
+    size_t positive = 0;           // live elements with nonzero weight
+    double total = 0;
+    size_t updatesSinceRebuild = 0;
+    RNG rng;
+
+    static void checkWeight(double w) {
+        if (!(w >= 0) || w == std::numeric_limits<double>::infinity()) {
+            throw std::runtime_error("Weight must be finite and non-negative");
+        }
+    }
+
+    // Individually finite weights can still overflow the running sum,
+    // and sampling from an infinite total cannot land on any slot.
+    void checkTotal(double oldWeight, double w) const {
+        if (!std::isfinite(total - oldWeight + w)) {
+            throw std::runtime_error("Total weight must stay finite");
+        }
+    }
+
+    void checkId(size_t id) const {
+        if (id >= live.size() || !live[id]) {
+            throw std::runtime_error("Invalid element id");
+        }
+    }
+
+    double prefix(size_t i) const {   // sum of weights[0, i)
+        double s = 0;
+        for (; i > 0; i -= i & (~i + 1)) s += tree[i];
+        return s;
+    }
+
+    void change(size_t slot, double delta) {
+        for (size_t i = slot + 1; i < tree.size(); i += i & (~i + 1)) tree[i] += delta;
+    }
+
+    // Incremental updates leave rounding error in the tree and in total;
+    // after as many updates as there are slots, rebuild both in O(n).
+    void setWeight(size_t slot, double w) {
+        if ((weights[slot] > 0) != (w > 0)) {
+            positive += w > 0 ? 1 : -1;
+        }
+        change(slot, w - weights[slot]);
+        total += w - weights[slot];
+        weights[slot] = w;
+        // Cancellation can also wipe out a small weight entirely, e.g.
+        // adding and removing 1e17 next to a 1; rebuild at once then.
+        if (++updatesSinceRebuild > weights.size() || (total <= 0 && positive > 0)) {
+            rebuild();
+        }
+    }
+
+    void rebuild() {
+        total = 0;
+        for (size_t i = 1; i < tree.size(); ++i) {
+            tree[i] = weights[i - 1];
+            total += weights[i - 1];
+        }
+        for (size_t i = 1; i < tree.size(); ++i) {
+            size_t parent = i + (i & (~i + 1));
+            if (parent < tree.size()) tree[parent] += tree[i];
+        }
+        updatesSinceRebuild = 0;
+    }
+
+    // Smallest slot whose running weight sum exceeds u. A draw that lands
+    // on a zero-weight slot or past the end because of rounding rebuilds
+    // the tree from the exact weights, if it has drifted, and is redrawn.
+    // With exact sums a miss has probability at most about 2^-52, so a
+    // run of misses means the tree is unusable and we give up.
+    size_t pick() {
+        if (positive == 0) {
+            throw std::runtime_error("Cannot sample from queue with zero total weight");
+        }
+        size_t top = 1;
+        while (top * 2 < tree.size()) top *= 2;
+        for (int attempt = 0; attempt < 64; ++attempt) {
+            double u = std::generate_canonical<double, 53>(rng) * total;
+            size_t pos = 0;
+            for (size_t step = top; step > 0; step /= 2) {
+                if (pos + step < tree.size() && tree[pos + step] <= u) {
+                    pos += step;
+                    u -= tree[pos];
+                }
+            }
+            if (pos < weights.size() && weights[pos] > 0) {
+                return pos;
+            }
+            if (updatesSinceRebuild > 0) {
+                rebuild();
+            }
+        }
+        throw std::runtime_error("Weighted sampling failed to find an element");
+    }
+
+public:
+    WeightedRandomQueue() : tree(1), rng(std::random_device{}()) {}
+
+    explicit WeightedRandomQueue(uint64_t seed) : tree(1), rng(seed) {}
+
+    // Adds x with weight w and returns its id, valid until it is removed.
+    size_t add(const T& x, double w) {
+        checkWeight(w);
+        checkTotal(0, w);
+        size_t slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+            items[slot] = x;
+        } else {
+            slot = items.size();
+            items.push_back(x);
+            weights.push_back(0);
+            live.push_back(0);
+            // A new Fenwick node covers the slots (i - lowbit(i), i].
+            size_t i = tree.size();
+            tree.push_back(prefix(i - 1) - prefix(i - (i & (~i + 1))));
+        }
+        live[slot] = 1;
+        ++count;
+        setWeight(slot, w);
+        return slot;
+    }
+
+    T remove() {
+        if (empty()) {
+            throw std::runtime_error("Cannot remove from empty queue");
+        }
+        size_t slot = pick();
+        T result = std::move(items[slot]);
+        setWeight(slot, 0);
+        live[slot] = 0;
+        freeSlots.push_back(slot);
+        --count;
+        return result;
+    }
+
+    // Returns a weighted random element without removing it.
+    const T& sample() {
+        if (empty()) {
+            throw std::runtime_error("Cannot sample from empty queue");
+        }
+        return items[pick()];
+    }
+
+    void update_weight(size_t id, double w) {
+        checkId(id);
+        checkWeight(w);
+        checkTotal(weights[id], w);
+        setWeight(id, w);
+    }
+
+    double weight(size_t id) const {
+        checkId(id);
+        return weights[id];
+    }
+
+    double totalWeight() const {
+        return total;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    size_t size() const {
+        return count;
+    }
+};
+
+/**
+ * Static weighted sampling for a fixed set, by Vose's alias method:
+ * O(n) construction, then every sample is one uniform slot plus one
+ * biased coin flip, O(1) regardless of how skewed the weights are.
+ */
+template<typename T, typename RNG = std::mt19937>
+class AliasSampler {
+private:
+    std::vector<T> items;
+    std::vector<double> prob;
+    std::vector<size_t> alias;
+    RNG rng;
+
+    void build(const std::vector<double>& weights) {
+        if (weights.size() != items.size()) {
+            throw std::runtime_error("Need exactly one weight per item");
+        }
+        if (items.empty()) {
+            throw std::runtime_error("Cannot sample from empty set");
+        }
+        size_t n = weights.size();
+        double sum = 0;
+        for (double w : weights) {
+            if (!(w >= 0) || w == std::numeric_limits<double>::infinity()) {
+                throw std::runtime_error("Weight must be finite and non-negative");
+            }
+            sum += w;
+        }
+        if (sum <= 0) {
+            throw std::runtime_error("Cannot sample from set with zero total weight");
+        }
+
+        prob.resize(n);
+        alias.resize(n);
+        std::vector<size_t> small, large;
+        for (size_t i = 0; i < n; ++i) {
+            prob[i] = weights[i] * n / sum;
+            (prob[i] < 1 ? small : large).push_back(i);
+        }
+        while (!small.empty() && !large.empty()) {
+            size_t s = small.back(), l = large.back();
+            small.pop_back();
+            alias[s] = l;
+            prob[l] -= 1 - prob[s];
+            if (prob[l] < 1) {
+                large.pop_back();
+                small.push_back(l);
+            }
+        }
+        // Whatever is left is 1 up to rounding.
+        for (size_t i : large) prob[i] = 1;
+        for (size_t i : small) prob[i] = 1;
+    }
+
+public:
+    AliasSampler(std::vector<T> xs, const std::vector<double>& weights)
+        : items(std::move(xs)), rng(std::random_device{}()) {
+        build(weights);
+    }
+
+    AliasSampler(std::vector<T> xs, const std::vector<double>& weights, uint64_t seed)
+        : items(std::move(xs)), rng(seed) {
+        build(weights);
+    }
+
+    const T& sample() {
+        size_t i = boundedRandom(rng, items.size());
+        return std::generate_canonical<double, 53>(rng) < prob[i] ? items[i] : items[alias[i]];
+    }
+
+    size_t size() const {
+        return items.size();
+    }
+};
+
+
+/**
+ * A random queue for many threads. Elements are spread over shards, each
+ * with its own lock, array and RNG, so threads working on different shards
+ * never contend. Each thread is assigned a home shard round-robin on first
+ * use; add() goes to the home shard, and tryRemove() takes a uniform
+ * element of the home shard, stealing from the other shards, starting at
+ * a random one, when it is empty. Removal is therefore uniform within a
+ * shard and only approximately uniform over the whole queue, which is the
+ * price of not having a global lock.
+ */
+template<typename T, typename RNG = Xoshiro256StarStar>
+class ConcurrentRandomQueue {
+private:
+    struct alignas(64) Shard {
+        std::mutex lock;
+        std::vector<T> data;
+        std::atomic<size_t> size{0};   // mirrors data.size() for lock-free reads
+        RNG rng;
+    };
+
+    std::unique_ptr<Shard[]> shards;
+    size_t shardCount;
+
+    static size_t threadIndex() {
+        static std::atomic<size_t> nextThread{0};
+        thread_local size_t index = nextThread.fetch_add(1, std::memory_order_relaxed);
+        return index;
+    }
+
+    static SplitMix64& threadRng() {
+        thread_local SplitMix64 rng(0x2545f4914f6cdd1dULL * (threadIndex() + 1));
+        return rng;
+    }
+
+    std::optional<T> takeFrom(Shard& s) {
+        std::lock_guard<std::mutex> guard(s.lock);
+        if (s.data.empty()) {
+            return std::nullopt;
+        }
+        size_t i = boundedRandom(s.rng, s.data.size());
+        std::optional<T> out(std::move(s.data[i]));
+        if (i != s.data.size() - 1) {
+            s.data[i] = std::move(s.data.back());
+        }
+        s.data.pop_back();
+        s.size.store(s.data.size(), std::memory_order_relaxed);
+        return out;
+    }
+
+    void init(uint64_t seed) {
+        if (shardCount == 0) {
+            throw std::runtime_error("Need at least one shard");
+        }
+        shards.reset(new Shard[shardCount]);
+        SplitMix64 expand(seed);
+        for (size_t i = 0; i < shardCount; ++i) {
+            shards[i].rng = RNG(expand());
+        }
+    }
+
+public:
+    explicit ConcurrentRandomQueue(size_t shardCount = std::max(1u, std::thread::hardware_concurrency()))
+        : shardCount(shardCount) {
+        init(std::random_device{}());
+    }
+
+    ConcurrentRandomQueue(size_t shardCount, uint64_t seed) : shardCount(shardCount) {
+        init(seed);
+    }
+
+    void add(const T& x) {
+        Shard& s = shards[threadIndex() % shardCount];
+        std::lock_guard<std::mutex> guard(s.lock);
+        s.data.push_back(x);
+        s.size.store(s.data.size(), std::memory_order_relaxed);
+    }
+
+    // Removes an element, or returns nothing if every shard was empty
+    // when visited.
+    std::optional<T> tryRemove() {
+        size_t home = threadIndex() % shardCount;
+        if (std::optional<T> out = takeFrom(shards[home])) {
+            return out;
+        }
+        size_t start = boundedRandom(threadRng(), shardCount);
+        for (size_t k = 0; k < shardCount; ++k) {
+            size_t victim = (start + k) % shardCount;
+            if (victim == home) continue;
+            if (std::optional<T> out = takeFrom(shards[victim])) {
+                return out;
+            }
+        }
+        return std::nullopt;
+    }
+
+    bool tryRemove(T& out) {
+        std::optional<T> x = tryRemove();
+        if (!x) {
+            return false;
+        }
+        out = std::move(*x);
+        return true;
+    }
+
+    T remove() {
+        std::optional<T> x = tryRemove();
+        if (!x) {
+            throw std::runtime_error("Cannot remove from empty queue");
+        }
+        return std::move(*x);
+    }
+
+    // Exact when no other thread is modifying the queue.
+    size_t size() const {
+        size_t n = 0;
+        for (size_t i = 0; i < shardCount; ++i) {
+            n += shards[i].size.load(std::memory_order_relaxed);
+        }
+        return n;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    size_t shardCount() const {
+        return shardCount;
     }
 };
 
+/**
+ * Shuffles [first, last) uniformly using several threads, by MergeShuffle
+ * (Bacher, Bodini, Hollender, Lumbroso): cut the range into power-of-two
+ * many blocks of about blockSize elements, Fisher-Yates each block on its
+ * own, then merge neighbouring blocks level by level. A merge walks both
+ * halves once, taking the next element from either side by a fair coin
+ * flip, and places whatever remains when one side runs out by Fisher-Yates
+ * insertion; the result is a uniform shuffle of the union. Blocks and
+ * merges at one level are independent, so they are spread over threads,
+ * and each one streams through contiguous memory. The upper levels have
+ * fewer merges than threads and the last merge is one sequential pass
+ * over the whole range, which bounds the speed-up.
+ *
+ * Every block and merge has its own engine derived from seed, and the
+ * block layout depends only on the length, so the permutation depends
+ * only on seed and not on the number of threads.
+ */
+template<typename RandomIt, typename RNG = Xoshiro256StarStar>
+void parallelShuffle(RandomIt first, RandomIt last, uint64_t seed,
+                     unsigned threads = 0, size_t blockSize = 1 << 18) {
+    using std::swap;
+    size_t n = static_cast<size_t>(last - first);
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    size_t blocks = 1;
+    while (blocks * 2 * std::max<size_t>(blockSize, 1) <= n) {
+        blocks *= 2;
+    }
+    auto bound = [&](size_t b) { return first + static_cast<std::ptrdiff_t>(n * b / blocks); };
+
+    // Runs task(0) .. task(tasks - 1) on up to `threads` threads.
+    auto runTasks = [threads](size_t tasks, auto task) {
+        size_t workers = std::min<size_t>(threads, tasks);
+        if (workers <= 1) {
+            for (size_t k = 0; k < tasks; ++k) task(k);
+            return;
+        }
+        std::atomic<size_t> next{0};
+        std::vector<std::thread> pool;
+        for (size_t t = 0; t < workers; ++t) {
+            pool.emplace_back([&] {
+                for (size_t k; (k = next.fetch_add(1)) < tasks;) task(k);
+            });
+        }
+        for (auto& th : pool) th.join();
+    };
 
+    SplitMix64 levelSeeds(seed);
+    std::vector<RNG> engines = makeStreams<RNG>(levelSeeds(), blocks);
+    runTasks(blocks, [&](size_t b) {
+        RandomIt lo = bound(b);
+        RNG& g = engines[b];
+        for (size_t i = static_cast<size_t>(bound(b + 1) - lo); i > 1; --i) {
+            swap(lo[i - 1], lo[boundedRandom(g, i)]);
+        }
+    });
+
+    for (size_t width = 1; width < blocks; width *= 2) {
+        size_t merges = blocks / (2 * width);
+        engines = makeStreams<RNG>(levelSeeds(), merges);
+        runTasks(merges, [&](size_t k) {
+            RandomIt lo = bound(2 * k * width);
+            RandomIt i = lo;
+            RandomIt j = bound((2 * k + 1) * width);
+            RandomIt hi = bound((2 * k + 2) * width);
+            RNG& g = engines[k];
+            bool done = false;
+            while (!done) {
+                uint64_t bits = (static_cast<uint64_t>(random32(g)) << 32) | random32(g);
+                for (int b = 0; b < 64; ++b, ++i) {
+                    bool fromRight = (bits >> b) & 1;
+                    if (fromRight ? j == hi : i == j) {
+                        done = true;
+                        break;
+                    }
+                    // The coin is unpredictable, so select instead of
+                    // branch: taking from the left swaps *i with itself.
+                    RandomIt pick = fromRight ? j : i;
+                    swap(*i, *pick);
+                    j += fromRight;
+                }
+            }
+            for (; i < hi; ++i) {
+                swap(*i, lo[boundedRandom(g, static_cast<size_t>(i - lo) + 1)]);
+            }
+        });
+    }
+}
 
 // Example usage and test function
 void testRandomQueue() {
@@ -79,6 +1088,840 @@ void testRandomQueue() {
     }
 };
 
+void testRemoveMany() {
+    std::cout << "\nTesting removeMany...\n";
+
+    RandomQueue<int> rq;
+    for (int i = 0; i < 100; ++i) {
+        rq.add(i);
+    }
+
+    std::vector<int> drained;
+    rq.removeMany(30, drained);
+    rq.removeMany(0, drained);
+    std::cout << "Drained " << drained.size() << ", remaining size: " << rq.size() << std::endl;
+
+    rq.removeMany(rq.size(), drained);
+    std::vector<bool> seen(100, false);
+    bool correct = drained.size() == 100 && rq.empty();
+    for (int x : drained) {
+        correct = correct && !seen[x];
+        seen[x] = true;
+    }
+    std::cout << "Every element removed exactly once: " << (correct ? "PASSED" : "FAILED") << std::endl;
+
+    try {
+        rq.removeMany(1, drained);
+    } catch (const std::exception& e) {
+        std::cout << "Expected exception: " << e.what() << std::endl;
+    }
+}
+
+void benchRemoveMany() {
+    std::cout << "\nDraining 1000000 elements in batches of 5000...\n";
+    const int n = 1000000;
+
+    RandomQueue<int> single;
+    RandomQueue<int> batched;
+    for (int i = 0; i < n; ++i) {
+        single.add(i);
+        batched.add(i);
+    }
+
+    long long sum = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    while (!single.empty()) {
+        sum += single.remove();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "remove() loop: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << " us\n";
+
+    std::vector<int> out;
+    start = std::chrono::high_resolution_clock::now();
+    while (!batched.empty()) {
+        out.clear();
+        batched.removeMany(5000, out);
+        for (int x : out) sum -= x;
+    }
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "removeMany(5000): "
+              << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << " us"
+              << (sum == 0 ? "" : " (MISMATCH)") << "\n";
+}
+
+template<typename RNG>
+void benchEngine(const char* name) {
+    const int n = 1000000;
+    RandomQueue<int, RNG> rq(12345);
+    for (int i = 0; i < n; ++i) {
+        rq.add(i);
+    }
+    long long sum = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    while (!rq.empty()) {
+        sum += rq.remove();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(end - start).count() / n;
+    std::cout << name << ": " << ns << " ns per remove()"
+              << (sum == static_cast<long long>(n) * (n - 1) / 2 ? "" : " (MISMATCH)") << std::endl;
+}
+
+void benchEngines() {
+    std::cout << "\nremove() throughput per engine (1000000 elements)...\n";
+    benchEngine<std::mt19937>("std::mt19937");
+    benchEngine<std::mt19937_64>("std::mt19937_64");
+    benchEngine<SplitMix64>("SplitMix64");
+    benchEngine<Xoshiro256StarStar>("Xoshiro256StarStar");
+    benchEngine<Pcg32>("Pcg32");
+}
+
+void testBoundedRandom() {
+    std::cout << "\nTesting boundedRandom...\n";
+    Pcg32 g(7);
+    const int range = 6;
+    const int draws = 60000;
+    int counts[range] = {};
+    bool inRange = true;
+    for (int i = 0; i < draws; ++i) {
+        size_t x = boundedRandom(g, range);
+        inRange = inRange && x < static_cast<size_t>(range);
+        if (inRange) ++counts[x];
+    }
+    bool balanced = true;
+    for (int c : counts) {
+        balanced = balanced && c > draws / range * 9 / 10 && c < draws / range * 11 / 10;
+    }
+    std::cout << "Draws in range and roughly uniform: " << (inRange && balanced ? "PASSED" : "FAILED") << std::endl;
+
+    RandomQueue<int, Xoshiro256StarStar> a(99), b(99);
+    bool same = true;
+    for (int i = 0; i < 100; ++i) {
+        a.add(i);
+        b.add(i);
+    }
+    while (!a.empty()) {
+        same = same && a.remove() == b.remove();
+    }
+    std::cout << "Same seed, same removal order: " << (same ? "PASSED" : "FAILED") << std::endl;
+}
+
+void testWeightedRandomQueue() {
+    std::cout << "\nTesting WeightedRandomQueue...\n";
+
+    WeightedRandomQueue<char> wq(42);
+    wq.add('a', 1);
+    wq.add('b', 2);
+    size_t c = wq.add('c', 3);
+    size_t d = wq.add('d', 4);
+
+    const int draws = 100000;
+    int counts[4] = {};
+    for (int i = 0; i < draws; ++i) {
+        ++counts[wq.sample() - 'a'];
+    }
+    bool proportional = true;
+    for (int i = 0; i < 4; ++i) {
+        double expected = draws * (i + 1) / 10.0;
+        proportional = proportional && counts[i] > expected * 0.95 && counts[i] < expected * 1.05;
+    }
+    std::cout << "Samples proportional to weight: " << (proportional ? "PASSED" : "FAILED") << std::endl;
+
+    wq.update_weight(d, 0);
+    wq.update_weight(c, 0.5);
+    bool zeroSkipped = true;
+    for (int i = 0; i < 10000; ++i) {
+        zeroSkipped = zeroSkipped && wq.sample() != 'd';
+    }
+    std::cout << "Zero-weight element never sampled: " << (zeroSkipped ? "PASSED" : "FAILED") << std::endl;
+
+    WeightedRandomQueue<int> drain(7);
+    for (int i = 0; i < 1000; ++i) {
+        drain.add(i, 1 + i % 5);
+    }
+    std::vector<bool> seen(1000, false);
+    bool correct = true;
+    bool refilled = false;
+    while (!drain.empty()) {
+        int x = drain.remove();
+        correct = correct && !seen[x];
+        seen[x] = true;
+        if (drain.size() == 500 && !refilled) {
+            refilled = true;
+            // Put x back; it must land in a freed slot.
+            size_t id = drain.add(x, 1);
+            correct = correct && id < 1000;
+            seen[x] = false;
+        }
+    }
+    for (bool b : seen) correct = correct && b;
+    std::cout << "Every element removed exactly once: " << (correct ? "PASSED" : "FAILED") << std::endl;
+
+    // Cancellation in the running sums must not leave a live weight unreachable.
+    WeightedRandomQueue<int> drift(1);
+    for (int i = 0; i < 1000; ++i) drift.add(i, 0);
+    drift.update_weight(0, 0);
+    drift.update_weight(0, 1e17);
+    drift.update_weight(1, 1);
+    drift.update_weight(0, 0);
+    bool recovered = drift.totalWeight() == 1 && drift.sample() == 1 && drift.remove() == 1;
+    std::cout << "Recovers from rounding drift: " << (recovered ? "PASSED" : "FAILED") << std::endl;
+
+    // Two huge weights are each finite but their sum is not; the second
+    // add must be refused rather than leave pick() nothing to land on.
+    WeightedRandomQueue<int> huge(7);
+    size_t hugeId = huge.add(1, 1e308);
+    bool refused = false;
+    try {
+        huge.add(2, 1e308);
+    } catch (const std::runtime_error&) {
+        refused = true;
+    }
+    size_t smallId = huge.add(3, 1);
+    try {
+        huge.update_weight(smallId, 1e308);
+        refused = false;
+    } catch (const std::runtime_error&) {
+    }
+    huge.update_weight(hugeId, 1e300);
+    refused = refused && huge.size() == 2 && std::isfinite(huge.totalWeight()) && huge.sample() == 1;
+    std::cout << "Rejects weights that overflow the total: " << (refused ? "PASSED" : "FAILED") << std::endl;
+
+    try {
+        wq.add('e', -1);
+    } catch (const std::exception& e) {
+        std::cout << "Expected exception: " << e.what() << std::endl;
+    }
+
+    AliasSampler<char> alias({'a', 'b', 'c', 'd'}, {1, 2, 3, 4}, 42);
+    int aliasCounts[4] = {};
+    for (int i = 0; i < draws; ++i) {
+        ++aliasCounts[alias.sample() - 'a'];
+    }
+    proportional = true;
+    for (int i = 0; i < 4; ++i) {
+        double expected = draws * (i + 1) / 10.0;
+        proportional = proportional && aliasCounts[i] > expected * 0.95 && aliasCounts[i] < expected * 1.05;
+    }
+    std::cout << "AliasSampler proportional to weight: " << (proportional ? "PASSED" : "FAILED") << std::endl;
+}
+
+// Baseline: one pass over the weights per draw.
+size_t linearWeightedPick(const std::vector<double>& weights, double total, std::mt19937& rng) {
+    double u = std::generate_canonical<double, 53>(rng) * total;
+    for (size_t i = 0; i < weights.size(); ++i) {
+        if (u < weights[i]) return i;
+        u -= weights[i];
+    }
+    return weights.size() - 1;
+}
+
+void benchWeightedSelection() {
+    const int n = 20000;
+    std::cout << "\nWeighted selection over " << n << " elements...\n";
+    std::vector<double> w(n);
+    std::vector<int> xs(n);
+    for (int i = 0; i < n; ++i) {
+        w[i] = 1 + i % 100;
+        xs[i] = i;
+    }
+
+    std::mt19937 rng(1);
+    std::vector<double> scan = w;
+    double total = 0;
+    for (double x : scan) total += x;
+    long long checksum = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    while (!scan.empty()) {
+        size_t i = linearWeightedPick(scan, total, rng);
+        total -= scan[i];
+        checksum += static_cast<long long>(scan[i]);
+        scan[i] = scan.back();
+        scan.pop_back();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "Linear scan, drain all: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << " us\n";
+
+    WeightedRandomQueue<int> wq(1);
+    for (int i = 0; i < n; ++i) wq.add(i, w[i]);
+    start = std::chrono::high_resolution_clock::now();
+    while (!wq.empty()) {
+        checksum -= static_cast<long long>(w[wq.remove()]);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "WeightedRandomQueue, drain all: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << " us"
+              << (checksum == 0 ? "" : " (MISMATCH)") << "\n";
+
+    const int draws = 1000000;
+    for (int i = 0; i < n; ++i) wq.add(i, w[i]);
+    long long sink = 0;
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < draws; ++i) sink += wq.sample();
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "WeightedRandomQueue, " << draws << " samples: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << " us\n";
+
+    AliasSampler<int> alias(xs, w, 1);
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < draws; ++i) sink += alias.sample();
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "AliasSampler, " << draws << " samples: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << " us"
+              << (sink > 0 ? "" : " (MISMATCH)") << "\n";
+}
+
+void testConcurrentRandomQueue() {
+    std::cout << "\nTesting ConcurrentRandomQueue...\n";
+
+    const int threads = 4;
+    const int perThread = 10000;
+    ConcurrentRandomQueue<int> cq(threads, 42);
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&cq, t] {
+            for (int i = 0; i < perThread; ++i) {
+                cq.add(t * perThread + i);
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+    std::cout << "Size after concurrent adds: " << cq.size() << std::endl;
+
+    // Half the threads drain more slowly, so the others have to steal.
+    std::vector<std::vector<int>> removed(threads);
+    workers.clear();
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&cq, &removed, t] {
+            int x;
+            while (cq.tryRemove(x)) {
+                removed[t].push_back(x);
+                if (t % 2 == 1) std::this_thread::yield();
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    std::vector<bool> seen(threads * perThread, false);
+    bool correct = cq.empty();
+    size_t total = 0;
+    for (const auto& r : removed) {
+        total += r.size();
+        for (int x : r) {
+            correct = correct && !seen[x];
+            seen[x] = true;
+        }
+    }
+    correct = correct && total == seen.size();
+    std::cout << "Every element removed exactly once: " << (correct ? "PASSED" : "FAILED") << std::endl;
+
+    // A thread with an empty home shard steals everything another thread added.
+    ConcurrentRandomQueue<int> steal(8, 7);
+    std::thread producer([&steal] {
+        for (int i = 0; i < 100; ++i) steal.add(i);
+    });
+    producer.join();
+    int stolen = 0, x;
+    while (steal.tryRemove(x)) ++stolen;
+    std::cout << "Stealing drains other shards: " << (stolen == 100 ? "PASSED" : "FAILED") << std::endl;
+
+    // Element types need not be default-constructible, as for RandomQueue.
+    struct NoDefault {
+        explicit NoDefault(int v) : v(v) {}
+        int v;
+    };
+    ConcurrentRandomQueue<NoDefault> plain(2, 3);
+    plain.add(NoDefault(5));
+    std::optional<NoDefault> got = plain.tryRemove();
+    plain.add(NoDefault(6));
+    bool noDefault = got && got->v == 5 && plain.remove().v == 6 && !plain.tryRemove();
+    std::cout << "Works without a default constructor: " << (noDefault ? "PASSED" : "FAILED") << std::endl;
+
+    try {
+        steal.remove();
+    } catch (const std::exception& e) {
+        std::cout << "Expected exception: " << e.what() << std::endl;
+    }
+}
+
+// Each thread adds and removes in turn against either one RandomQueue
+// behind a global mutex or a ConcurrentRandomQueue with a shard per thread.
+void benchConcurrentRandomQueue() {
+    const int totalOps = 2000000;
+    std::cout << "\nConcurrent add/remove, " << totalOps << " operations in total"
+              << " (" << std::thread::hardware_concurrency() << " hardware threads)...\n";
+    for (int threads : {1, 2, 4, 8, 16, 32}) {
+        int perThread = totalOps / threads / 2;
+
+        RandomQueue<int, Xoshiro256StarStar> global(1);
+        std::mutex globalLock;
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&] {
+                for (int i = 0; i < perThread; ++i) {
+                    {
+                        std::lock_guard<std::mutex> guard(globalLock);
+                        global.add(i);
+                    }
+                    if (i % 2 == 1) {
+                        for (int k = 0; k < 2; ++k) {
+                            std::lock_guard<std::mutex> guard(globalLock);
+                            if (!global.empty()) global.remove();
+                        }
+                    }
+                }
+            });
+        }
+        for (auto& w : workers) w.join();
+        auto end = std::chrono::high_resolution_clock::now();
+        long long globalUs = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+        ConcurrentRandomQueue<int> sharded(threads, 1);
+        start = std::chrono::high_resolution_clock::now();
+        workers.clear();
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&] {
+                int x;
+                for (int i = 0; i < perThread; ++i) {
+                    sharded.add(i);
+                    if (i % 2 == 1) {
+                        sharded.tryRemove(x);
+                        sharded.tryRemove(x);
+                    }
+                }
+            });
+        }
+        for (auto& w : workers) w.join();
+        end = std::chrono::high_resolution_clock::now();
+        long long shardedUs = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+        std::cout << threads << " threads: global lock " << globalUs << " us, sharded "
+                  << shardedUs << " us\n";
+    }
+}
+
+// Pcg32 that counts how often it is called.
+struct CountingPcg32 : Pcg32 {
+    static inline long long calls = 0;
+    using Pcg32::Pcg32;
+    result_type operator()() {
+        ++calls;
+        return Pcg32::operator()();
+    }
+};
+
+void testReservoir() {
+    std::cout << "\nTesting reservoir mode...\n";
+
+    // Each of 20 items should survive in a 5-slot reservoir a quarter of the time.
+    const int trials = 20000;
+    std::vector<int> kept(20, 0);
+    for (int t = 0; t < trials; ++t) {
+        RandomQueue<int, Pcg32> rq(t);
+        rq.setCapacity(5);
+        for (int i = 0; i < 20; ++i) rq.add(i);
+        while (!rq.empty()) ++kept[rq.remove()];
+    }
+    bool uniform = true;
+    for (int c : kept) {
+        uniform = uniform && c > trials / 4 * 0.93 && c < trials / 4 * 1.07;
+    }
+    std::cout << "Every item kept with probability k/n: " << (uniform ? "PASSED" : "FAILED") << std::endl;
+
+    // Same check through addRange, which jumps over skipped items.
+    std::vector<int> stream(20);
+    for (int i = 0; i < 20; ++i) stream[i] = i;
+    std::fill(kept.begin(), kept.end(), 0);
+    for (int t = 0; t < trials; ++t) {
+        RandomQueue<int, Pcg32> rq(t);
+        rq.setCapacity(5);
+        rq.addRange(stream.begin(), stream.end());
+        while (!rq.empty()) ++kept[rq.remove()];
+    }
+    uniform = true;
+    for (int c : kept) {
+        uniform = uniform && c > trials / 4 * 0.93 && c < trials / 4 * 1.07;
+    }
+    std::cout << "addRange keeps the same distribution: " << (uniform ? "PASSED" : "FAILED") << std::endl;
+
+    RandomQueue<int, CountingPcg32> rq(1);
+    rq.setCapacity(100);
+    const int n = 1000000;
+    for (int i = 0; i < n; ++i) rq.add(i);
+    std::cout << "Seen " << rq.seen() << ", kept " << rq.size() << ", RNG calls " << CountingPcg32::calls << std::endl;
+    std::cout << "Memory bounded and most items free: "
+              << (rq.size() == 100 && rq.seen() == static_cast<uint64_t>(n) && CountingPcg32::calls < n / 100 ? "PASSED" : "FAILED")
+              << std::endl;
+
+    // Shrinking an existing queue keeps a uniform subset and continues the stream.
+    RandomQueue<int> shrink(3);
+    for (int i = 0; i < 50; ++i) shrink.add(i);
+    shrink.setCapacity(10);
+    for (int i = 50; i < 100; ++i) shrink.add(i);
+    std::cout << "setCapacity on a full queue: "
+              << (shrink.size() == 10 && shrink.seen() == 100 ? "PASSED" : "FAILED") << std::endl;
+}
+
+// Algorithm R draws one random index per item; Algorithm L only draws
+// for the O(k log(n/k)) items it accepts.
+void benchReservoir() {
+    const size_t k = 100;
+    const int n = 10000000;
+    std::cout << "\nReservoir sampling " << k << " of " << n << " items...\n";
+
+    Xoshiro256StarStar rng(1);
+    std::vector<int> reservoir;
+    long long sink = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < n; ++i) {
+        if (reservoir.size() < k) {
+            reservoir.push_back(i);
+        } else {
+            size_t j = boundedRandom(rng, static_cast<size_t>(i) + 1);
+            if (j < k) reservoir[j] = i;
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    for (int x : reservoir) sink += x;
+    std::cout << "Algorithm R: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << " us\n";
+
+    RandomQueue<int, Xoshiro256StarStar> rq(1);
+    rq.setCapacity(k);
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < n; ++i) rq.add(i);
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "RandomQueue::add (Algorithm L): "
+              << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << " us\n";
+
+    std::vector<int> stream(n);
+    for (int i = 0; i < n; ++i) stream[i] = i;
+    RandomQueue<int, Xoshiro256StarStar> ranged(1);
+    ranged.setCapacity(k);
+    start = std::chrono::high_resolution_clock::now();
+    ranged.addRange(stream.begin(), stream.end());
+    end = std::chrono::high_resolution_clock::now();
+    while (!ranged.empty()) sink += ranged.remove();
+    std::cout << "RandomQueue::addRange (Algorithm L): "
+              << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << " us"
+              << (sink > 0 ? "" : " (MISMATCH)") << "\n";
+}
+
+void testSampleAndShuffled() {
+    std::cout << "\nTesting sample and shuffled iteration...\n";
+
+    RandomQueue<int, Pcg32> rq(5);
+    for (int i = 0; i < 10; ++i) rq.add(i);
+    const RandomQueue<int, Pcg32>& view = rq;
+    std::cout << "peek on a const queue: " << view.peek() << std::endl;
+
+    const int trials = 50000;
+    std::vector<int> picked(10, 0);
+    bool distinct = true;
+    for (int t = 0; t < trials; ++t) {
+        std::vector<int> s = view.sample(3);
+        std::vector<bool> seen(10, false);
+        for (int x : s) {
+            distinct = distinct && !seen[x];
+            seen[x] = true;
+            ++picked[x];
+        }
+    }
+    bool uniform = true;
+    for (int c : picked) {
+        uniform = uniform && c > trials * 3 / 10 * 0.95 && c < trials * 3 / 10 * 1.05;
+    }
+    std::cout << "sample(3) distinct and uniform, queue untouched: "
+              << (distinct && uniform && rq.size() == 10 ? "PASSED" : "FAILED") << std::endl;
+
+    std::vector<int> order;
+    auto shuffled = view.shuffled();
+    for (int x : shuffled) order.push_back(x);
+    std::vector<int> sorted = order;
+    std::sort(sorted.begin(), sorted.end());
+    bool permutation = sorted.size() == 10;
+    for (int i = 0; i < static_cast<int>(sorted.size()); ++i) {
+        permutation = permutation && sorted[i] == i;
+    }
+    std::cout << "Shuffled iteration visits every element once: " << (permutation ? "PASSED" : "FAILED") << std::endl;
+
+    // Position of element 0 in the shuffled order should be uniform.
+    std::vector<int> firstPos(10, 0);
+    for (int t = 0; t < trials; ++t) {
+        int p = 0;
+        for (int x : view.shuffled()) {
+            if (x == 0) break;
+            ++p;
+        }
+        ++firstPos[p];
+    }
+    uniform = true;
+    for (int c : firstPos) {
+        uniform = uniform && c > trials / 10 * 0.93 && c < trials / 10 * 1.07;
+    }
+    std::cout << "Shuffled order uniform: " << (uniform ? "PASSED" : "FAILED") << std::endl;
+
+    try {
+        view.sample(11);
+    } catch (const std::exception& e) {
+        std::cout << "Expected exception: " << e.what() << std::endl;
+    }
+}
+
+// Repeated A/B buckets of 1000 from a pool of 1000000: copy and shuffle
+// the whole pool each time versus reading a prefix of a lazy shuffle.
+void benchSample() {
+    const int n = 1000000;
+    const size_t k = 1000;
+    const int rounds = 20;
+    std::cout << "\n" << rounds << " samples of " << k << " from " << n << " elements...\n";
+
+    RandomQueue<int, Xoshiro256StarStar> rq(1);
+    for (int i = 0; i < n; ++i) rq.add(i);
+
+    Xoshiro256StarStar rng(1);
+    long long sink = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        std::vector<int> copy(n);
+        for (int i = 0; i < n; ++i) copy[i] = i;
+        std::shuffle(copy.begin(), copy.end(), rng);
+        for (size_t i = 0; i < k; ++i) sink += copy[i];
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "Copy + std::shuffle: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << " us\n";
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (int x : rq.sample(k)) sink -= x;
+    }
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "RandomQueue::sample: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << " us"
+              << (rq.size() == static_cast<size_t>(n) ? "" : " (MISMATCH)") << "\n";
+}
+
+// Counts copies and moves so tests can check how elements are relocated.
+struct Tracked {
+    static inline int copies = 0;
+    static inline int moves = 0;
+    int value;
+
+    Tracked(int v = 0) : value(v) {}
+    Tracked(const Tracked& o) : value(o.value) { ++copies; }
+    Tracked(Tracked&& o) noexcept : value(o.value) { ++moves; }
+    Tracked& operator=(const Tracked& o) { value = o.value; ++copies; return *this; }
+    Tracked& operator=(Tracked&& o) noexcept { value = o.value; ++moves; return *this; }
+};
+
+void testMoveSemantics() {
+    std::cout << "\nTesting move-only paths...\n";
+
+    RandomQueue<Tracked, Pcg32> rq(3);
+    rq.add(Tracked(1));
+    rq.emplace(2);
+    Tracked three(3);
+    rq.add(std::move(three));
+    for (int i = 4; i <= 100; ++i) rq.emplace(i);
+    int addCopies = Tracked::copies;
+
+    Tracked::copies = 0;
+    Tracked::moves = 0;
+    int sum = 0;
+    int removals = 0;
+    while (!rq.empty()) {
+        sum += rq.remove().value;
+        ++removals;
+    }
+    std::cout << "Copies: " << addCopies << " on add, " << Tracked::copies << " on remove; "
+              << Tracked::moves << " moves for " << removals << " removals" << std::endl;
+    std::cout << "No copies, at most two moves per remove: "
+              << (addCopies == 0 && Tracked::copies == 0 && Tracked::moves <= 2 * removals && sum == 5050
+                  ? "PASSED" : "FAILED") << std::endl;
+
+    RandomQueue<std::unique_ptr<int>> owners;
+    for (int i = 0; i < 10; ++i) owners.emplace(new int(i));
+    owners.add(std::make_unique<int>(10));
+    int ownedSum = 0;
+    while (!owners.empty()) ownedSum += *owners.remove();
+    std::cout << "Move-only element type: " << (ownedSum == 55 ? "PASSED" : "FAILED") << std::endl;
+}
+
+// 1 KB heap payloads: the old remove() copied the pick and then swapped,
+// the new one moves it out and moves the last element into the hole.
+void benchMoveRemove() {
+    const int n = 200000;
+    std::cout << "\nDraining " << n << " 1 KB payloads...\n";
+
+    RandomQueue<std::vector<char>, Xoshiro256StarStar> rq(1);
+    std::vector<std::vector<char>> old;
+    for (int i = 0; i < n; ++i) {
+        rq.emplace(1024, static_cast<char>(i));
+        old.emplace_back(1024, static_cast<char>(i));
+    }
+
+    Xoshiro256StarStar rng(1);
+    long long sink = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    while (!old.empty()) {
+        size_t i = boundedRandom(rng, old.size());
+        std::vector<char> result = old[i];
+        if (i != old.size() - 1) std::swap(old[i], old.back());
+        old.pop_back();
+        sink += result[0];
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "Copy and swap: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << " us\n";
+
+    start = std::chrono::high_resolution_clock::now();
+    while (!rq.empty()) {
+        sink -= rq.remove()[0];
+    }
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "Move out: "
+              << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() << " us"
+              << (sink == 0 ? "" : " (MISMATCH)") << "\n";
+}
+
+// One simulation step per worker: fill a queue, drain it, fold the order
+// into a checksum.
+template<typename RNG>
+std::vector<uint64_t> runWorkers(uint64_t seed, int workers) {
+    std::vector<RNG> streams = makeStreams<RNG>(seed, workers);
+    std::vector<uint64_t> results(workers);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < workers; ++t) {
+        threads.emplace_back([&, t] {
+            RandomQueue<int, RNG> rq(streams[t]);
+            for (int i = 0; i < 1000; ++i) rq.add(i);
+            uint64_t h = 0;
+            while (!rq.empty()) h = h * 31 + rq.remove();
+            results[t] = h;
+        });
+    }
+    for (auto& th : threads) th.join();
+    return results;
+}
+
+void testReproducibleStreams() {
+    std::cout << "\nTesting reproducible RNG streams...\n";
+
+    Pcg32 stepped(11), advanced(11);
+    for (int i = 0; i < 12345; ++i) stepped();
+    advanced.advance(12345);
+    SplitMix64 smStepped(11), smSkipped(11);
+    for (int i = 0; i < 777; ++i) smStepped();
+    smSkipped.discard(777);
+    std::cout << "advance/discard match stepping: "
+              << (stepped == advanced && stepped() == advanced() && smStepped == smSkipped ? "PASSED" : "FAILED")
+              << std::endl;
+
+    Xoshiro256StarStar base(5), jumped(5), longJumped(5);
+    jumped.jump();
+    longJumped.long_jump();
+    bool differ = base != jumped && jumped != longJumped && base() != jumped();
+    std::cout << "jump/long_jump move to other streams: " << (differ ? "PASSED" : "FAILED") << std::endl;
+
+    bool roundTrip = true;
+    {
+        std::stringstream ss;
+        Pcg32 a(3, 9), b;
+        a.advance(100);
+        ss << a;
+        ss >> b;
+        roundTrip = roundTrip && a == b;
+    }
+    {
+        std::stringstream ss;
+        Xoshiro256StarStar a(3), b;
+        a.jump();
+        ss << a;
+        ss >> b;
+        roundTrip = roundTrip && a == b;
+    }
+    std::cout << "Engine state survives << and >>: " << (roundTrip ? "PASSED" : "FAILED") << std::endl;
+
+    RandomQueue<int, Xoshiro256StarStar> rq(17);
+    for (int i = 0; i < 50; ++i) rq.add(i);
+    Xoshiro256StarStar saved = rq.snapshot();
+    std::vector<int> first, second;
+    while (!rq.empty()) first.push_back(rq.remove());
+    rq.restore(saved);
+    for (int i = 0; i < 50; ++i) rq.add(i);
+    while (!rq.empty()) second.push_back(rq.remove());
+    std::cout << "Snapshot/restore repeats removals: " << (first == second ? "PASSED" : "FAILED") << std::endl;
+
+    auto runA = runWorkers<Xoshiro256StarStar>(2024, 4);
+    auto runB = runWorkers<Xoshiro256StarStar>(2024, 4);
+    auto pcgA = runWorkers<Pcg32>(2024, 4);
+    auto pcgB = runWorkers<Pcg32>(2024, 4);
+    auto mtA = runWorkers<std::mt19937_64>(2024, 4);
+    auto mtB = runWorkers<std::mt19937_64>(2024, 4);
+    bool independent = runA[0] != runA[1] && pcgA[0] != pcgA[1] && mtA[0] != mtA[1];
+    std::cout << "Parallel runs reproducible, workers independent: "
+              << (runA == runB && pcgA == pcgB && mtA == mtB && independent ? "PASSED" : "FAILED") << std::endl;
+}
+
+void testParallelShuffle() {
+    std::cout << "\nTesting parallelShuffle...\n";
+
+    std::vector<int> v(100000);
+    for (int i = 0; i < static_cast<int>(v.size()); ++i) v[i] = i;
+    std::vector<int> a = v, b = v;
+    parallelShuffle(a.begin(), a.end(), 9, 4, 1000);
+    parallelShuffle(b.begin(), b.end(), 9, 1, 1000);
+    std::vector<int> sorted = a;
+    std::sort(sorted.begin(), sorted.end());
+    std::cout << "Result is a permutation: " << (sorted == v && a != v ? "PASSED" : "FAILED") << std::endl;
+    std::cout << "Same seed, any thread count, same result: " << (a == b ? "PASSED" : "FAILED") << std::endl;
+
+    // With one-element blocks every permutation of 4 comes from merges only.
+    const int trials = 120000;
+    std::vector<int> counts(256, 0);
+    for (int t = 0; t < trials; ++t) {
+        int p[4] = {0, 1, 2, 3};
+        parallelShuffle(p, p + 4, t, 1, 1);
+        ++counts[p[0] * 64 + p[1] * 16 + p[2] * 4 + p[3]];
+    }
+    int distinct = 0;
+    bool uniform = true;
+    for (int c : counts) {
+        if (c == 0) continue;
+        ++distinct;
+        uniform = uniform && c > trials / 24 * 0.95 && c < trials / 24 * 1.05;
+    }
+    std::cout << "All 24 permutations equally likely: " << (distinct == 24 && uniform ? "PASSED" : "FAILED") << std::endl;
+}
+
+void benchParallelShuffle() {
+    const int n = 10000000;
+    std::cout << "\nShuffling " << n << " ints (" << std::thread::hardware_concurrency()
+              << " hardware threads)...\n";
+    std::vector<int> v(n);
+    for (int i = 0; i < n; ++i) v[i] = i;
+
+    Xoshiro256StarStar rng(1);
+    auto start = std::chrono::high_resolution_clock::now();
+    std::shuffle(v.begin(), v.end(), rng);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "std::shuffle: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms\n";
+
+    for (unsigned threads : {1u, 2u, 4u, 8u, 16u}) {
+        start = std::chrono::high_resolution_clock::now();
+        parallelShuffle(v.begin(), v.end(), 1, threads);
+        end = std::chrono::high_resolution_clock::now();
+        std::cout << "parallelShuffle, " << threads << " threads: "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << " ms\n";
+    }
+}
+
 /**
  * COMPLEXITY ANALYSIS:
  * 
@@ -91,6 +1934,31 @@ void testRandomQueue() {
  * - Swap operation: O(1)
  * - pop_back(): O(1)
  * 
+ * removeMany(k): O(k)
+ * - One random index and one swap per element, then a single erase
+ * 
+ * sample(k), and the first m steps of shuffled(): O(k) and O(m)
+ * - Expected time, using a hash map of displaced positions
+ * 
+ * parallelShuffle over n elements with p threads: O(n log(n / blockSize) / p + n)
+ * - Work is O(n) per merge level over log(n / blockSize) levels
+ * - Each merge is one sequential pass, and the top log p levels have
+ *   fewer merges than threads; the last is a single pass over all n
+ *   elements, so the critical path is Omega(n) whatever p is
+ * 
+ * add(x) in reservoir mode: O(1), with RNG work only for accepted items
+ * - About k(1 + ln(n/k)) of n items are accepted; addRange() does not
+ *   even touch the rest. Space stays O(k)
+ * 
+ * WeightedRandomQueue add/remove/sample/update_weight: O(log n)
+ * - One Fenwick tree update or descent each; an O(n) rebuild every n
+ *   updates bounds floating-point drift and stays O(1) amortized
+ * 
+ * AliasSampler: O(n) construction, O(1) per sample
+ * 
+ * ConcurrentRandomQueue add/tryRemove: O(1) plus one uncontended lock
+ * - A steal visits at most every shard once
+ * 
  * Space: O(n) where n is the number of elements
  */
 
@@ -109,9 +1977,13 @@ void testRandomQueue() {
  *    - push_back() and pop_back() are O(1)
  * 
  * 3. For random number generation:
- *    - std::mt19937 is a good general-purpose generator
- *    - You can either keep a distribution object or create it as needed
- *    - For small ranges, modulo operation is acceptable
+ *    - std::mt19937 is a good general-purpose generator, but it carries
+ *      about 5 KB of state; SplitMix64, Xoshiro256StarStar and Pcg32 are
+ *      much smaller and faster and can be passed as the RNG parameter
+ *    - boundedRandom() avoids both a distribution object and the modulo
+ *      bias of rng() % n with a single multiply per draw
+ *    - For parallel runs give every worker its own engine from
+ *      makeStreams() instead of sharing one behind a lock
  * 
  * 4. Consider edge cases:
  *    - Empty queue operations
@@ -121,5 +1993,22 @@ void testRandomQueue() {
 
 int main() {
     testRandomQueue();
+    testRemoveMany();
+    testBoundedRandom();
+    testWeightedRandomQueue();
+    testConcurrentRandomQueue();
+    testReservoir();
+    testSampleAndShuffled();
+    testMoveSemantics();
+    testReproducibleStreams();
+    testParallelShuffle();
+    benchRemoveMany();
+    benchEngines();
+    benchWeightedSelection();
+    benchConcurrentRandomQueue();
+    benchReservoir();
+    benchSample();
+    benchMoveRemove();
+    benchParallelShuffle();
     return 0;
 }
@@ -1,87 +1,458 @@
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
 #include <vector>
 #include <stdexcept>
+#include <utility>
 
+// Bytes one block should occupy at most; a block of this size is shifted by
+// add()/remove(), so keeping it cache resident bounds their cost. Override
+// with -DTREQUE_CACHE_TARGET_BYTES=... or Treque::set_cache_target().
+#ifndef TREQUE_CACHE_TARGET_BYTES
+#define TREQUE_CACHE_TARGET_BYTES 16384
+#endif
 
+#if defined(__GNUC__) || defined(__clang__)
+#define TREQUE_PREFETCH(addr, rw) __builtin_prefetch((addr), (rw))
+#else
+#define TREQUE_PREFETCH(addr, rw) ((void)(addr))
+#endif
+
+// An operation scans ~n/B block headers (about a cache line each) and
+// shifts ~B * sizeof(T) bytes, so B = sqrt(n * 64 / sizeof(T)) balances the
+// two. The result is clamped so one block fits in cache_bytes (and to at
+// least 16 elements when those still fit).
+template<typename T>
+int tuned_block_size(int n, std::size_t cache_bytes) {
+  int fit = static_cast<int>(std::max<std::size_t>(1, cache_bytes / sizeof(T)));
+  double lines_per_elem = 64.0 / static_cast<double>(sizeof(T));
+  int root = static_cast<int>(std::sqrt(n * lines_per_elem));
+  return std::max(std::min(16, fit), std::min(root, fit));
+}
 
 template<typename T>
 class Treque {
 private:
   std::vector<std::vector<T>> blocks;
+  std::vector<char> flipped;  // flipped[b]: blocks[b] is stored back to front
   int block_size;
   int total_size;
+  std::size_t cache_bytes;  // per-block byte budget used by auto-tuning
+  int fixed_block_size;     // > 0 disables auto-tuning
   
+  int target_block_size() const {
+    if (fixed_block_size > 0) return fixed_block_size;
+    return tuned_block_size<T>(total_size, cache_bytes);
+  }
+
   void rebuild_blocks() {
     int n = total_size;
-    int optimal_block_size = std::max(16, static_cast<int>(std::sqrt(n)));
     std::vector<T> flat;
-    for (auto& blk : blocks){
-      flat.insert(flat.end(), blk.begin(), blk.end());
+    flat.reserve(n);
+    for (std::size_t b = 0; b < blocks.size(); ++b){
+      std::vector<T>& blk = blocks[b];
+      if (flipped[b]) {
+        flat.insert(flat.end(), std::make_move_iterator(blk.rbegin()),
+                    std::make_move_iterator(blk.rend()));
+      } else {
+        flat.insert(flat.end(), std::make_move_iterator(blk.begin()),
+                    std::make_move_iterator(blk.end()));
+      }
     }
     blocks.clear();
-    block_size = optimal_block_size;
+    block_size = target_block_size();
     for (int i = 0; i < n; i+= block_size) {
-      blocks.emplace_back(flat.begin() + i, flat.begin() + std::min(n, i + block_size));
+      blocks.emplace_back(std::make_move_iterator(flat.begin() + i),
+                          std::make_move_iterator(flat.begin() + std::min(n, i + block_size)));
+    }
+    flipped.assign(blocks.size(), 0);
+  }
+
+  // Storage slot of logical offset off within blocks[b].
+  int slot(std::size_t b, int off) const {
+    return flipped[b] ? static_cast<int>(blocks[b].size()) - 1 - off : off;
+  }
+
+  // Maps global index i to a block index, leaving the in-block offset in i.
+  // Returns blocks.size() (offset 0) when i == total_size.
+  std::size_t locate(int& i) const {
+    for (std::size_t b = 0; b < blocks.size(); ++b) {
+      int sz = static_cast<int>(blocks[b].size());
+      if (i < sz) return b;
+      i -= sz;
+    }
+    i = 0;
+    return blocks.size();
+  }
+
+  // How many batch entries ahead get_many()/set_many() prefetch.
+  static constexpr std::size_t prefetch_distance = 8;
+
+  // Resolves every index of a batch to (block, offset) with one prefix-sum
+  // pass, then orders the batch positions block by block with a stable
+  // counting sort. Blocks are near block_size long, so i / block_size is
+  // tried first and a binary search is the fallback. Throws before anything
+  // is touched if an index is out of range.
+  void group_by_block(const std::vector<int>& indices, std::vector<int>& block_of,
+                      std::vector<int>& offset_of, std::vector<std::size_t>& order) const {
+    std::vector<int> starts(blocks.size() + 1, 0);
+    for (std::size_t b = 0; b < blocks.size(); ++b) {
+      starts[b + 1] = starts[b] + static_cast<int>(blocks[b].size());
+    }
+    std::size_t k = indices.size();
+    block_of.resize(k);
+    offset_of.resize(k);
+    std::vector<std::size_t> bucket(blocks.size() + 1, 0);
+    for (std::size_t j = 0; j < k; ++j) {
+      int i = indices[j];
+      if (i < 0 || i >= total_size) throw std::out_of_range("index out of range");
+      int b = std::min(i / block_size, static_cast<int>(blocks.size()) - 1);
+      if (starts[b] > i || starts[b + 1] <= i) {
+        b = static_cast<int>(std::upper_bound(starts.begin(), starts.end(), i) - starts.begin()) - 1;
+      }
+      block_of[j] = b;
+      offset_of[j] = slot(b, i - starts[b]);
+      ++bucket[b + 1];
+    }
+    for (std::size_t b = 1; b < bucket.size(); ++b) bucket[b] += bucket[b - 1];
+    order.resize(k);
+    for (std::size_t j = 0; j < k; ++j) order[bucket[block_of[j]]++] = j;
+  }
+
+  // Splits blocks[b] at logical offset off; the tail becomes blocks[b + 1]
+  // and keeps the orientation of the block it came from.
+  void split_block(std::size_t b, int off) {
+    std::vector<T>& blk = blocks[b];
+    std::vector<T> tail;
+    if (flipped[b]) {
+      int cut = static_cast<int>(blk.size()) - off;
+      tail.assign(std::make_move_iterator(blk.begin()),
+                  std::make_move_iterator(blk.begin() + cut));
+      blk.erase(blk.begin(), blk.begin() + cut);
+    } else {
+      tail.assign(std::make_move_iterator(blk.begin() + off),
+                  std::make_move_iterator(blk.end()));
+      blk.erase(blk.begin() + off, blk.end());
+    }
+    char orientation = flipped[b];
+    blocks.insert(blocks.begin() + b + 1, std::move(tail));
+    flipped.insert(flipped.begin() + b + 1, orientation);
+  }
+
+  // Flattens once if the block size or block count has drifted too far
+  // from what rebuild_blocks() would pick for the current size.
+  void rebalance() {
+    int target = target_block_size();
+    int expected_blocks = total_size / block_size + 1;
+    if (2 * block_size < target || block_size > 2 * target ||
+        static_cast<int>(blocks.size()) > 2 * expected_blocks + 2) {
+      rebuild_blocks();
     }
   }
 
 public:
-  Treque() : block_size(16), total_size(0) {};
+  // Positional inserts and removes recorded for one Treque::apply(). All
+  // positions refer to the sequence as it is before the batch: add(i, x)
+  // puts x in front of the element now at i (i == size() appends), and
+  // inserts at the same position keep their recording order.
+  class EditBatch {
+  private:
+    friend class Treque;
+    std::vector<std::pair<int, T>> inserts;
+    std::vector<int> removals;
+
+  public:
+    void add(int i, const T& x) {
+      inserts.emplace_back(i, x);
+    }
+
+    void remove(int i) {
+      removals.push_back(i);
+    }
+
+    std::size_t size() const {
+      return inserts.size() + removals.size();
+    }
+
+    bool empty() const {
+      return size() == 0;
+    }
+
+    void clear() {
+      inserts.clear();
+      removals.clear();
+    }
+  };
+
+  Treque()
+      : block_size(0), total_size(0),
+        cache_bytes(TREQUE_CACHE_TARGET_BYTES), fixed_block_size(0) {
+    block_size = target_block_size();
+  }
+
+  // Runtime override of the compile-time cache target; re-blocks at once.
+  void set_cache_target(std::size_t bytes) {
+    if (bytes == 0) throw std::invalid_argument("cache target must be positive");
+    cache_bytes = bytes;
+    rebuild_blocks();
+  }
+
+  // Pins the block size (b > 0) or returns to auto-tuning (b == 0).
+  void set_block_size(int b) {
+    if (b < 0) throw std::invalid_argument("block size must be non-negative");
+    fixed_block_size = b;
+    rebuild_blocks();
+  }
+
+  int get_block_size() const {
+    return block_size;
+  }
   
  
   T get(int i) const {
     if (i < 0 || i >= total_size) throw std::out_of_range("index out of range");
-    int idx = i;
-    for (const auto& blk : blocks) {
-      if (idx < blk.size()) return blk[idx];
-      idx -= blk.size();
-    }
-    throw std::logic_error("failed to locate index");
+    std::size_t b = locate(i);
+    return blocks[b][slot(b, i)];
   }
   
   void set(int i, const T& x) {
     if (i < 0 || i >= total_size) throw std::out_of_range("index out of range");
-    for (auto& blk : blocks) {
-      if(i < blk.size()) {
-        blk[i] = x;
-        return;
-      }
-      i -= blk.size();
-    } 
-    throw std::logic_error("Failed to locate index for set");
+    std::size_t b = locate(i);
+    blocks[b][slot(b, i)] = x;
   }
   
   void add(int i, const T& x) {
     if (i < 0 || i > total_size) throw std::out_of_range("index out of range");
-    for (auto& blk : blocks) {
-      if(i < blk.size()) {
-       blk.insert(blk.begin() + i, x);      
-        ++total_size;
-        if(blk.size() > 2 * block_size) rebuild_blocks();
-        return;
+    if (i == total_size) {
+      // Appends skip the block scan; opening a new tail block is the point
+      // where a growing block count gets rebalanced.
+      ++total_size;
+      if (!blocks.empty() && static_cast<int>(blocks.back().size()) < block_size) {
+        std::vector<T>& tail = blocks.back();
+        tail.insert(flipped.back() ? tail.begin() : tail.end(), x);
+      } else {
+        blocks.emplace_back(1, x);
+        flipped.push_back(0);
+        rebalance();
       }
-      i -= blk.size();
+      return;
     }
-     blocks.emplace_back(1, x);
+    std::size_t b = locate(i);
+    std::vector<T>& blk = blocks[b];
+    int pos = flipped[b] ? static_cast<int>(blk.size()) - i : i;
+    blk.insert(blk.begin() + pos, x);
     ++total_size;
+    if(blk.size() > 2 * block_size) rebuild_blocks();
   }
   
   
+  // Inserts [first, last) before index i. The range is cut into full
+  // blocks that are spliced in at i, so at most one block is split and
+  // at most one rebuild_blocks() runs, instead of one per element.
+  template<typename InputIt>
+  void insertRange(int i, InputIt first, InputIt last) {
+    if (i < 0 || i > total_size) throw std::out_of_range("index out of range");
+    std::vector<std::vector<T>> fresh;
+    int k = 0;
+    while (first != last) {
+      fresh.emplace_back();
+      std::vector<T>& blk = fresh.back();
+      blk.reserve(block_size);
+      for (; first != last && static_cast<int>(blk.size()) < block_size; ++first) {
+        blk.push_back(*first);
+        ++k;
+      }
+    }
+    if (k == 0) return;
+
+    std::size_t b = locate(i);
+    if (i > 0) {
+      split_block(b, i);
+      ++b;
+    }
+    blocks.insert(blocks.begin() + b, std::make_move_iterator(fresh.begin()),
+                  std::make_move_iterator(fresh.end()));
+    flipped.insert(flipped.begin() + b, fresh.size(), 0);
+    total_size += k;
+    rebalance();
+  }
+
   T remove(int i) {
     if (i < 0 || i >= total_size) throw std::out_of_range("index out of range");
-    for (auto& blk : blocks) {
-      if(i< blk.size()) {
-         T val = blk[i];
-        blk.erase(blk.begin() + i);
-        --total_size;
-        return val;
+    std::size_t b = locate(i);
+    std::vector<T>& blk = blocks[b];
+    int pos = slot(b, i);
+    T val = std::move(blk[pos]);
+    blk.erase(blk.begin() + pos);
+    --total_size;
+    return val;
+  }
+
+  // Applies a whole EditBatch in one left-to-right sweep: the edits are
+  // sorted, blocks without edits are moved over untouched, blocks with
+  // edits are rewritten into full blocks, and the result is rebalanced
+  // once. Costs O(n / B + k log k + B * touched blocks) for k edits. The
+  // batch is validated first, so a bad position leaves the Treque as is.
+  void apply(EditBatch& batch) {
+    auto& inserts = batch.inserts;
+    auto& removals = batch.removals;
+    std::stable_sort(inserts.begin(), inserts.end(),
+                     [](const std::pair<int, T>& a, const std::pair<int, T>& b) { return a.first < b.first; });
+    std::sort(removals.begin(), removals.end());
+    if (!inserts.empty() && (inserts.front().first < 0 || inserts.back().first > total_size)) {
+      throw std::out_of_range("index out of range");
+    }
+    if (!removals.empty() && (removals.front() < 0 || removals.back() >= total_size)) {
+      throw std::out_of_range("index out of range");
+    }
+    if (std::adjacent_find(removals.begin(), removals.end()) != removals.end()) {
+      throw std::invalid_argument("element removed twice in one batch");
+    }
+
+    std::vector<std::vector<T>> out;
+    std::vector<char> out_flipped;
+    std::vector<T> cur;
+    auto flush = [&] {
+      if (cur.empty()) return;
+      out.push_back(std::move(cur));
+      out_flipped.push_back(0);
+      cur = std::vector<T>();
+    };
+    auto emit = [&](T&& x) {
+      if (cur.empty()) cur.reserve(block_size);
+      cur.push_back(std::move(x));
+      if (static_cast<int>(cur.size()) == block_size) flush();
+    };
+    // Moves logical offsets [lo, hi) of blocks[b] out in bulk.
+    auto emit_run = [&](std::size_t b, int lo, int hi) {
+      std::vector<T>& blk = blocks[b];
+      while (lo < hi) {
+        if (cur.empty()) cur.reserve(block_size);
+        int take = std::min(hi - lo, block_size - static_cast<int>(cur.size()));
+        if (flipped[b]) {
+          cur.insert(cur.end(), std::make_move_iterator(blk.rbegin() + lo),
+                     std::make_move_iterator(blk.rbegin() + lo + take));
+        } else {
+          cur.insert(cur.end(), std::make_move_iterator(blk.begin() + lo),
+                     std::make_move_iterator(blk.begin() + lo + take));
+        }
+        lo += take;
+        if (static_cast<int>(cur.size()) == block_size) flush();
       }
-      i -= blk.size();
+    };
+
+    std::size_t ii = 0, ri = 0;
+    int start = 0;
+    for (std::size_t b = 0; b < blocks.size(); ++b) {
+      int sz = static_cast<int>(blocks[b].size());
+      int end = start + sz;
+      bool touched = (ii < inserts.size() && inserts[ii].first < end) ||
+                     (ri < removals.size() && removals[ri] < end);
+      if (!touched) {
+        if (sz > 0) {
+          flush();
+          out.push_back(std::move(blocks[b]));
+          out_flipped.push_back(flipped[b]);
+        }
+      } else {
+        for (int off = 0; off < sz;) {
+          int next = end;
+          if (ii < inserts.size()) next = std::min(next, inserts[ii].first);
+          if (ri < removals.size()) next = std::min(next, removals[ri]);
+          if (next - start > off) {
+            emit_run(b, off, next - start);
+            off = next - start;
+            continue;
+          }
+          for (; ii < inserts.size() && inserts[ii].first == start + off; ++ii) {
+            emit(std::move(inserts[ii].second));
+          }
+          if (ri < removals.size() && removals[ri] == start + off) {
+            ++ri;
+          } else {
+            emit(std::move(blocks[b][slot(b, off)]));
+          }
+          ++off;
+        }
+      }
+      start = end;
     }
-    throw std::logic_error("Failed to locate index for removal");
+    for (; ii < inserts.size(); ++ii) emit(std::move(inserts[ii].second));
+    flush();
+
+    total_size += static_cast<int>(inserts.size()) - static_cast<int>(removals.size());
+    blocks = std::move(out);
+    flipped = std::move(out_flipped);
+    batch.clear();
+    rebalance();
+  }
+
+  // Reverses the elements at indices [i, j). The range is cut at both ends
+  // so it covers whole blocks; those blocks are reordered and have their
+  // orientation flag toggled, so only the two boundary blocks are copied
+  // element by element and the cost is O(B + (j - i) / B).
+  void reverse(int i, int j) {
+    if (i < 0 || j > total_size || i > j) throw std::out_of_range("index out of range");
+    if (j - i < 2) return;
+    std::size_t first = locate(i);
+    if (i > 0) {
+      split_block(first, i);
+      ++first;
+    }
+    std::size_t last = locate(j);
+    if (j > 0) {
+      split_block(last, j);
+      ++last;
+    }
+    std::reverse(blocks.begin() + first, blocks.begin() + last);
+    std::reverse(flipped.begin() + first, flipped.begin() + last);
+    for (std::size_t b = first; b < last; ++b) flipped[b] = !flipped[b];
+    rebalance();
   }
   
+  // Batched get: out[k] = get(indices[k]). Indices are resolved together and
+  // visited block by block while the element a few entries ahead is
+  // prefetched, so neither the index scan nor the cache misses are paid per
+  // element.
+  void get_many(const std::vector<int>& indices, std::vector<T>& out) const {
+    std::vector<int> block_of, offset_of;
+    std::vector<std::size_t> order;
+    group_by_block(indices, block_of, offset_of, order);
+    out.resize(indices.size());
+    for (std::size_t p = 0; p < order.size(); ++p) {
+      if (p + prefetch_distance < order.size()) {
+        std::size_t ahead = order[p + prefetch_distance];
+        TREQUE_PREFETCH(&blocks[block_of[ahead]][offset_of[ahead]], 0);
+      }
+      std::size_t j = order[p];
+      out[j] = blocks[block_of[j]][offset_of[j]];
+    }
+  }
+
+  // Batched set: set(indices[k], values[k]). When an index repeats, the
+  // value that appears last in the batch wins.
+  void set_many(const std::vector<int>& indices, const std::vector<T>& values) {
+    if (indices.size() != values.size()) {
+      throw std::invalid_argument("indices and values differ in length");
+    }
+    std::vector<int> block_of, offset_of;
+    std::vector<std::size_t> order;
+    group_by_block(indices, block_of, offset_of, order);
+    for (std::size_t p = 0; p < order.size(); ++p) {
+      if (p + prefetch_distance < order.size()) {
+        std::size_t ahead = order[p + prefetch_distance];
+        TREQUE_PREFETCH(&blocks[block_of[ahead]][offset_of[ahead]], 1);
+      }
+      std::size_t j = order[p];
+      blocks[block_of[j]][offset_of[j]] = values[j];
+    }
+  }
+
   int size() const {
    return total_size;
   }
@@ -91,9 +462,693 @@ public:
   }
 };
 
+// Fenwick (binary indexed) tree over non-negative counts, e.g. block sizes.
+// Point updates and "which slot holds rank i" both take O(log n).
+class FenwickIndex {
+private:
+  std::vector<int> tree;  // 1-based
+
+public:
+  template<typename CountOf>
+  void build(std::size_t n, CountOf count_of) {
+    tree.assign(n + 1, 0);
+    for (std::size_t k = 1; k <= n; ++k) {
+      tree[k] += count_of(k - 1);
+      std::size_t parent = k + (k & (~k + 1));
+      if (parent <= n) tree[parent] += tree[k];
+    }
+  }
+
+  void update(std::size_t k, int delta) {
+    for (std::size_t j = k + 1; j < tree.size(); j += j & (~j + 1)) tree[j] += delta;
+  }
+
+  // Descends to the slot holding rank i (i < total count) and leaves the
+  // rank within that slot in i.
+  std::size_t find(int& i) const {
+    std::size_t pos = 0;
+    std::size_t step = 1;
+    while (step * 2 < tree.size()) step *= 2;
+    for (; step > 0; step /= 2) {
+      if (pos + step < tree.size() && tree[pos + step] <= i) {
+        pos += step;
+        i -= tree[pos];
+      }
+    }
+    return pos;
+  }
+};
+
+// Treque layout with variable-size blocks. A Fenwick tree over the block
+// sizes resolves an index to its block in O(log(n/B)) instead of scanning
+// the blocks, and add()/remove() update it in O(log(n/B)). Blocks split in
+// half when they pass 2B and are dropped when they empty; only a split or a
+// drop rebuilds the Fenwick tree, which is O(n/B) once every ~B updates.
+template<typename T>
+class FenwickTreque {
+private:
+  std::vector<std::vector<T>> blocks;
+  FenwickIndex sizes;  // over blocks[b].size()
+  int block_size;
+  int total_size;
+
+  void rebuild_tree() {
+    sizes.build(blocks.size(), [this](std::size_t b) { return static_cast<int>(blocks[b].size()); });
+  }
+
+  // Re-blocks everything at the tuned size when the size has drifted.
+  void retune() {
+    int target = tuned_block_size<T>(total_size, TREQUE_CACHE_TARGET_BYTES);
+    if (2 * block_size >= target && block_size <= 2 * target) return;
+    std::vector<T> flat;
+    flat.reserve(total_size);
+    for (auto& blk : blocks) {
+      flat.insert(flat.end(), std::make_move_iterator(blk.begin()),
+                  std::make_move_iterator(blk.end()));
+    }
+    blocks.clear();
+    block_size = target;
+    for (int i = 0; i < total_size; i += block_size) {
+      blocks.emplace_back(std::make_move_iterator(flat.begin() + i),
+                          std::make_move_iterator(flat.begin() + std::min(total_size, i + block_size)));
+    }
+  }
+
+public:
+  FenwickTreque() : block_size(tuned_block_size<T>(0, TREQUE_CACHE_TARGET_BYTES)), total_size(0) {
+    rebuild_tree();
+  }
+
+  T get(int i) const {
+    if (i < 0 || i >= total_size) throw std::out_of_range("index out of range");
+    std::size_t b = sizes.find(i);
+    return blocks[b][i];
+  }
+
+  void set(int i, const T& x) {
+    if (i < 0 || i >= total_size) throw std::out_of_range("index out of range");
+    std::size_t b = sizes.find(i);
+    blocks[b][i] = x;
+  }
+
+  void add(int i, const T& x) {
+    if (i < 0 || i > total_size) throw std::out_of_range("index out of range");
+    std::size_t b;
+    if (i == total_size) {
+      if (blocks.empty()) blocks.emplace_back();
+      b = blocks.size() - 1;
+      i = static_cast<int>(blocks[b].size());
+    } else {
+      b = sizes.find(i);
+    }
+    std::vector<T>& blk = blocks[b];
+    blk.insert(blk.begin() + i, x);
+    ++total_size;
+    if (static_cast<int>(blk.size()) <= 2 * block_size) {
+      sizes.update(b, 1);
+      return;
+    }
+    int half = static_cast<int>(blk.size()) / 2;
+    std::vector<T> tail(std::make_move_iterator(blk.begin() + half),
+                        std::make_move_iterator(blk.end()));
+    blk.erase(blk.begin() + half, blk.end());
+    blocks.insert(blocks.begin() + b + 1, std::move(tail));
+    retune();
+    rebuild_tree();
+  }
+
+  T remove(int i) {
+    if (i < 0 || i >= total_size) throw std::out_of_range("index out of range");
+    std::size_t b = sizes.find(i);
+    std::vector<T>& blk = blocks[b];
+    T val = std::move(blk[i]);
+    blk.erase(blk.begin() + i);
+    --total_size;
+    if (!blk.empty()) {
+      sizes.update(b, -1);
+      return val;
+    }
+    blocks.erase(blocks.begin() + b);
+    retune();
+    rebuild_tree();
+    return val;
+  }
+
+  int size() const {
+    return total_size;
+  }
+
+  bool empty() const {
+    return total_size == 0;
+  }
+
+  int block_count() const {
+    return static_cast<int>(blocks.size());
+  }
+};
+
+// Treque for many concurrent readers and a few writers. Every block has its
+// own reader/writer latch on a separate cache line, so reads that land in
+// different blocks never touch shared memory. Block sizes live in their own
+// array and are guarded by a sequence counter (odd while a writer changes
+// them): a reader resolves its index optimistically, latches the block and
+// retries if the counter moved. Writers are serialized by one mutex and only
+// latch the block they edit; a re-block makes the counter odd and then latches
+// each block in use before or after it once, to wait for readers inside.
+// The block directory has a fixed capacity so readers never see it move.
+template<typename T>
+class ConcurrentTreque {
+private:
+  struct alignas(64) Block {
+    mutable std::shared_mutex latch;
+    std::vector<T> items;
+  };
+
+  std::unique_ptr<Block[]> slots;
+  std::unique_ptr<std::atomic<int>[]> counts;  // counts[b] == slots[b].items.size()
+  int max_blocks;
+  std::atomic<int> used_blocks;
+  std::atomic<unsigned> version;
+  std::atomic<int> total_size;
+  std::mutex writer;
+  int block_size;   // writer-only state
+
+  // Maps i to (block, offset) from the published sizes; readers validate
+  // the result against the version counter. Returns -1 past the end.
+  int locate(int& i) const {
+    int nb = used_blocks.load(std::memory_order_acquire);
+    for (int b = 0; b < nb; ++b) {
+      int c = counts[b].load(std::memory_order_relaxed);
+      if (i < c) return b;
+      i -= c;
+    }
+    return -1;
+  }
+
+  // Runs f(block, offset) under the block latch (shared or exclusive) once a
+  // consistent resolution of i has been found.
+  template<typename Lock, typename F>
+  void with_element(int i, F f) const {
+    if (i < 0) throw std::out_of_range("index out of range");
+    for (;;) {
+      unsigned v = version.load(std::memory_order_acquire);
+      if (v & 1) {
+        std::this_thread::yield();
+        continue;
+      }
+      int off = i;
+      int b = locate(off);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (b < 0) {
+        if (version.load(std::memory_order_relaxed) == v) throw std::out_of_range("index out of range");
+        continue;
+      }
+      Lock lk(slots[b].latch);
+      if (version.load(std::memory_order_acquire) != v) continue;
+      f(slots[b], off);
+      return;
+    }
+  }
+
+  // Writer side: called with `writer` held, so the sizes cannot move.
+  // Once the version is odd, a reader that latches a block afterwards
+  // fails validation and never touches its items, so it is enough to latch
+  // each block a reader can reach or the rebuild writes once, in turn, to
+  // wait out the readers already inside.
+  void rebuild_blocks() {
+    int n = total_size.load(std::memory_order_relaxed);
+    int fewest = (n + max_blocks / 2 - 1) / (max_blocks / 2);
+    block_size = std::max(tuned_block_size<T>(n, TREQUE_CACHE_TARGET_BYTES), fewest);
+    int nb = used_blocks.load(std::memory_order_relaxed);
+    int reach = std::max(nb, (n + block_size - 1) / block_size);
+    version.fetch_add(1);
+    for (int b = 0; b < reach; ++b) {
+      std::unique_lock<std::shared_mutex> drain(slots[b].latch);
+    }
+    std::vector<T> flat;
+    flat.reserve(n);
+    for (int b = 0; b < nb; ++b) {
+      std::vector<T>& items = slots[b].items;
+      flat.insert(flat.end(), std::make_move_iterator(items.begin()),
+                  std::make_move_iterator(items.end()));
+      items.clear();
+      counts[b].store(0, std::memory_order_relaxed);
+    }
+    nb = 0;
+    for (int i = 0; i < n; i += block_size, ++nb) {
+      slots[nb].items.assign(std::make_move_iterator(flat.begin() + i),
+                             std::make_move_iterator(flat.begin() + std::min(n, i + block_size)));
+      counts[nb].store(static_cast<int>(slots[nb].items.size()), std::memory_order_relaxed);
+    }
+    used_blocks.store(std::max(nb, 1), std::memory_order_release);
+    version.fetch_add(1);
+  }
+
+public:
+  explicit ConcurrentTreque(int max_blocks = 4096)
+      : slots(new Block[max_blocks]), counts(new std::atomic<int>[max_blocks]),
+        max_blocks(max_blocks), used_blocks(1), version(0), total_size(0),
+        block_size(tuned_block_size<T>(0, TREQUE_CACHE_TARGET_BYTES)) {
+    if (max_blocks < 2) throw std::invalid_argument("need at least two blocks");
+    for (int b = 0; b < max_blocks; ++b) counts[b].store(0, std::memory_order_relaxed);
+  }
+
+  T get(int i) const {
+    T result{};
+    with_element<std::shared_lock<std::shared_mutex>>(i, [&](const Block& blk, int off) {
+      result = blk.items[off];
+    });
+    return result;
+  }
+
+  void set(int i, const T& x) {
+    with_element<std::unique_lock<std::shared_mutex>>(i, [&](Block& blk, int off) {
+      blk.items[off] = x;
+    });
+  }
+
+  void add(int i, const T& x) {
+    std::lock_guard<std::mutex> guard(writer);
+    if (i < 0 || i > total_size.load(std::memory_order_relaxed)) throw std::out_of_range("index out of range");
+    int b;
+    if (i == total_size.load(std::memory_order_relaxed)) {
+      b = used_blocks.load(std::memory_order_relaxed) - 1;
+      i = counts[b].load(std::memory_order_relaxed);
+    } else {
+      b = locate(i);
+    }
+    bool overfull;
+    {
+      std::unique_lock<std::shared_mutex> lk(slots[b].latch);
+      version.fetch_add(1);
+      std::vector<T>& items = slots[b].items;
+      items.insert(items.begin() + i, x);
+      counts[b].store(static_cast<int>(items.size()), std::memory_order_relaxed);
+      total_size.fetch_add(1, std::memory_order_relaxed);
+      version.fetch_add(1);
+      overfull = static_cast<int>(items.size()) > 2 * block_size;
+    }
+    if (overfull) rebuild_blocks();
+  }
+
+  T remove(int i) {
+    std::lock_guard<std::mutex> guard(writer);
+    if (i < 0 || i >= total_size.load(std::memory_order_relaxed)) throw std::out_of_range("index out of range");
+    int b = locate(i);
+    std::unique_lock<std::shared_mutex> lk(slots[b].latch);
+    version.fetch_add(1);
+    std::vector<T>& items = slots[b].items;
+    T val = std::move(items[i]);
+    items.erase(items.begin() + i);
+    counts[b].store(static_cast<int>(items.size()), std::memory_order_relaxed);
+    total_size.fetch_sub(1, std::memory_order_relaxed);
+    version.fetch_add(1);
+    return val;
+  }
+
+  int size() const {
+    return total_size.load();
+  }
+
+  bool empty() const {
+    return size() == 0;
+  }
+};
+
+// Packed memory array: the sequence lives in one gapped array cut into
+// segments of Theta(log n) slots, each packed to its left. An implicit tree
+// over the segments bounds the density of every window (upper bound 1 at a
+// segment down to 3/4 at the root, lower bound 1/8 up to 1/4). An insert or
+// remove that breaks its segment's bound redistributes the smallest
+// enclosing window that is within bounds, which is O(log^2 n) amortized; at
+// the root the array doubles or halves. Elements stay in index order in
+// memory, so scans are sequential, and a Fenwick tree over the segment
+// counts resolves an index in O(log n).
+template<typename T>
+class PackedMemoryArray {
+private:
+  std::vector<T> slots;
+  std::vector<int> counts;  // elements held by each segment
+  FenwickIndex ranks;       // over counts
+  int segment_size;
+  int height;               // segments == 1 << height
+  int total_size;
+
+  int segments() const {
+    return 1 << height;
+  }
+
+  double upper_density(int h) const {
+    return height == 0 ? 1.0 : 1.0 - 0.25 * h / height;
+  }
+
+  double lower_density(int h) const {
+    return height == 0 ? 0.0 : 0.125 + 0.125 * h / height;
+  }
+
+  // Spreads items evenly over segments [first, first + segs), each packed
+  // to its left, and fixes up counts and ranks.
+  void spread(std::vector<T>& items, int first, int segs) {
+    int m = static_cast<int>(items.size());
+    int base = m / segs, extra = m % segs;
+    int k = 0;
+    for (int seg = first; seg < first + segs; ++seg) {
+      int c = base + (seg - first < extra ? 1 : 0);
+      T* out = &slots[static_cast<std::size_t>(seg) * segment_size];
+      for (int j = 0; j < c; ++j) out[j] = std::move(items[k++]);
+      ranks.update(seg, c - counts[seg]);
+      counts[seg] = c;
+    }
+  }
+
+  // Moves the elements of segments [first, first + segs) out in order.
+  std::vector<T> gather(int first, int segs) {
+    std::vector<T> items;
+    for (int seg = first; seg < first + segs; ++seg) {
+      T* in = &slots[static_cast<std::size_t>(seg) * segment_size];
+      items.insert(items.end(), std::make_move_iterator(in),
+                   std::make_move_iterator(in + counts[seg]));
+    }
+    return items;
+  }
+
+  // Re-lays the whole array out for about `capacity` slots: segments of the
+  // next power of two >= log2(capacity) (at least 8), a power-of-two
+  // segment count.
+  void relayout(std::size_t capacity, std::vector<T>& items) {
+    int lg = 0;
+    while ((std::size_t(1) << lg) < capacity) ++lg;
+    segment_size = 8;
+    while (segment_size < lg) segment_size *= 2;
+    std::size_t needed = (capacity + segment_size - 1) / segment_size;
+    height = 0;
+    while ((std::size_t(1) << height) < needed) ++height;
+    slots.assign(static_cast<std::size_t>(segments()) * segment_size, T());
+    counts.assign(segments(), 0);
+    ranks.build(segments(), [](std::size_t) { return 0; });
+    spread(items, 0, segments());
+  }
+
+  // Segment and in-segment position where index i (0 <= i <= size) goes.
+  int position(int i, int& off) const {
+    if (total_size == 0) {
+      off = 0;
+      return 0;
+    }
+    int r = i == total_size ? i - 1 : i;
+    int seg = static_cast<int>(ranks.find(r));
+    off = i == total_size ? r + 1 : r;
+    return seg;
+  }
+
+public:
+  PackedMemoryArray() : segment_size(8), height(0), total_size(0) {
+    std::vector<T> none;
+    relayout(8, none);
+  }
+
+  T get(int i) const {
+    if (i < 0 || i >= total_size) throw std::out_of_range("index out of range");
+    std::size_t seg = ranks.find(i);
+    return slots[seg * segment_size + i];
+  }
+
+  void set(int i, const T& x) {
+    if (i < 0 || i >= total_size) throw std::out_of_range("index out of range");
+    std::size_t seg = ranks.find(i);
+    slots[seg * segment_size + i] = x;
+  }
+
+  void add(int i, const T& x) {
+    if (i < 0 || i > total_size) throw std::out_of_range("index out of range");
+    int off;
+    int seg = position(i, off);
+    if (counts[seg] < segment_size) {
+      T* base = &slots[static_cast<std::size_t>(seg) * segment_size];
+      std::move_backward(base + off, base + counts[seg], base + counts[seg] + 1);
+      base[off] = x;
+      ++counts[seg];
+      ranks.update(seg, 1);
+      ++total_size;
+      return;
+    }
+    for (int h = 1; h <= height; ++h) {
+      int first = (seg >> h) << h;
+      int segs = 1 << h;
+      int used = 0, before = 0;
+      for (int k = first; k < first + segs; ++k) {
+        used += counts[k];
+        if (k < seg) before += counts[k];
+      }
+      if (used + 1 <= upper_density(h) * segs * segment_size) {
+        std::vector<T> items = gather(first, segs);
+        items.insert(items.begin() + before + off, x);
+        spread(items, first, segs);
+        ++total_size;
+        return;
+      }
+    }
+    std::vector<T> items = gather(0, segments());
+    items.insert(items.begin() + i, x);
+    relayout(2 * slots.size(), items);
+    ++total_size;
+  }
+
+  T remove(int i) {
+    if (i < 0 || i >= total_size) throw std::out_of_range("index out of range");
+    int seg = static_cast<int>(ranks.find(i));
+    T* base = &slots[static_cast<std::size_t>(seg) * segment_size];
+    T val = std::move(base[i]);
+    std::move(base + i + 1, base + counts[seg], base + i);
+    --counts[seg];
+    ranks.update(seg, -1);
+    --total_size;
+    if (counts[seg] >= lower_density(0) * segment_size) return val;
+    for (int h = 1; h <= height; ++h) {
+      int first = (seg >> h) << h;
+      int segs = 1 << h;
+      int used = 0;
+      for (int k = first; k < first + segs; ++k) used += counts[k];
+      if (used >= lower_density(h) * segs * segment_size) {
+        std::vector<T> items = gather(first, segs);
+        spread(items, first, segs);
+        return val;
+      }
+    }
+    std::vector<T> items = gather(0, segments());
+    relayout(std::max<std::size_t>(8, slots.size() / 2), items);
+    return val;
+  }
+
+  // Calls f on the elements at indices [i, j) in order, walking the array
+  // front to back.
+  template<typename F>
+  void scan(int i, int j, F f) const {
+    if (i < 0 || j > total_size || i > j) throw std::out_of_range("index out of range");
+    if (i == j) return;
+    int left = j - i;
+    std::size_t seg = ranks.find(i);
+    for (; left > 0; ++seg, i = 0) {
+      const T* base = &slots[seg * segment_size];
+      for (int k = i; k < counts[seg] && left > 0; ++k, --left) f(base[k]);
+    }
+  }
+
+  int size() const {
+    return total_size;
+  }
+
+  bool empty() const {
+    return total_size == 0;
+  }
+
+  int capacity() const {
+    return static_cast<int>(slots.size());
+  }
+};
+
+// Tiered vector of depth K generalizing Treque: a node at level h is a
+// circular array of L nodes of level h - 1 (level 1 holds L elements), so
+// the root holds L^K slots with L ~ n^(1/K). All nodes share one flat slot
+// array and each keeps only a rotation offset. Access walks K levels with
+// shifts and masks unrolled at compile time. An insert or remove shifts
+// elements inside the two partial children of each level and rotates the
+// full children between them by one, which only moves their offset, for
+// O(2^K * n^(1/K)) per update.
+template<typename T, int K>
+class TieredVector {
+  static_assert(K >= 1, "a tiered vector needs at least one level");
+
+private:
+  std::vector<T> slots;
+  std::vector<std::size_t> offsets[K];  // offsets[h - 1][node] at level h
+  int lg;                               // L == 1 << lg
+  int total_size;
+
+  std::size_t cap(int h) const {
+    return std::size_t(1) << (h * lg);
+  }
+
+  template<int H>
+  T& at(std::size_t node, std::size_t t) {
+    std::size_t q = (t + offsets[H - 1][node]) & (cap(H) - 1);
+    if constexpr (H == 1) {
+      return slots[(node << lg) + q];
+    } else {
+      return at<H - 1>((node << lg) + (q >> ((H - 1) * lg)), q & (cap(H - 1) - 1));
+    }
+  }
+
+  template<int H>
+  const T& at(std::size_t node, std::size_t t) const {
+    return const_cast<TieredVector*>(this)->template at<H>(node, t);
+  }
+
+  // Shifts logical [p, e) of a level-H node right by one, stores x at p and
+  // returns the element pushed out of e.
+  template<int H>
+  T insert_within(std::size_t node, std::size_t p, T x, std::size_t e) {
+    std::size_t c = cap(H);
+    if (p == 0 && e == c - 1) {
+      std::size_t& off = offsets[H - 1][node];
+      off = (off + c - 1) & (c - 1);
+      T& slot = at<H>(node, 0);
+      T out = std::move(slot);
+      slot = std::move(x);
+      return out;
+    }
+    if constexpr (H == 1) {
+      // Physical slots of p and e; the run between them wraps at most once.
+      T* base = &slots[node << lg];
+      std::size_t off = offsets[0][node];
+      std::size_t first = (p + off) & (c - 1), last = (e + off) & (c - 1);
+      T out = std::move(base[last]);
+      if (first <= last) {
+        std::move_backward(base + first, base + last, base + last + 1);
+      } else {
+        std::move_backward(base, base + last, base + last + 1);
+        base[0] = std::move(base[c - 1]);
+        std::move_backward(base + first, base + c - 1, base + c);
+      }
+      base[first] = std::move(x);
+      return out;
+    } else {
+      std::size_t sub = cap(H - 1);
+      std::size_t q = (p + offsets[H - 1][node]) & (c - 1);
+      for (std::size_t len = e - p + 1; len > 0;) {
+        std::size_t lo = q & (sub - 1);
+        std::size_t take = std::min(len, sub - lo);
+        std::size_t child = (node << lg) + (q >> ((H - 1) * lg));
+        x = insert_within<H - 1>(child, lo, std::move(x), lo + take - 1);
+        q = (q + take) & (c - 1);
+        len -= take;
+      }
+      return x;
+    }
+  }
+
+  // Removes and returns logical p of a level-H node, shifting (p, e] left by
+  // one and storing fill at e.
+  template<int H>
+  T remove_within(std::size_t node, std::size_t p, std::size_t e, T fill) {
+    std::size_t c = cap(H);
+    if (p == 0 && e == c - 1) {
+      std::size_t& off = offsets[H - 1][node];
+      T& slot = at<H>(node, 0);
+      T out = std::move(slot);
+      slot = std::move(fill);
+      off = (off + 1) & (c - 1);
+      return out;
+    }
+    if constexpr (H == 1) {
+      T* base = &slots[node << lg];
+      std::size_t off = offsets[0][node];
+      std::size_t first = (p + off) & (c - 1), last = (e + off) & (c - 1);
+      T out = std::move(base[first]);
+      if (first <= last) {
+        std::move(base + first + 1, base + last + 1, base + first);
+      } else {
+        std::move(base + first + 1, base + c, base + first);
+        base[c - 1] = std::move(base[0]);
+        std::move(base + 1, base + last + 1, base);
+      }
+      base[last] = std::move(fill);
+      return out;
+    } else {
+      std::size_t sub = cap(H - 1);
+      std::size_t q = (e + offsets[H - 1][node]) & (c - 1);
+      for (std::size_t len = e - p + 1; len > 0;) {
+        std::size_t hi = q & (sub - 1);
+        std::size_t take = std::min(len, hi + 1);
+        std::size_t child = (node << lg) + (q >> ((H - 1) * lg));
+        fill = remove_within<H - 1>(child, hi + 1 - take, hi, std::move(fill));
+        q = (q + c - take) & (c - 1);
+        len -= take;
+      }
+      return fill;
+    }
+  }
+
+  // Lays the elements out again for L == 1 << new_lg with zero offsets.
+  void relayout(int new_lg) {
+    std::vector<T> items;
+    items.reserve(total_size);
+    for (int i = 0; i < total_size; ++i) items.push_back(std::move(at<K>(0, i)));
+    lg = new_lg;
+    slots.assign(cap(K), T());
+    for (int h = 1; h <= K; ++h) offsets[h - 1].assign(cap(K - h), 0);
+    std::move(items.begin(), items.end(), slots.begin());
+  }
+
+public:
+  TieredVector() : lg(2), total_size(0) {
+    slots.assign(cap(K), T());
+    for (int h = 1; h <= K; ++h) offsets[h - 1].assign(cap(K - h), 0);
+  }
+
+  T get(int i) const {
+    if (i < 0 || i >= total_size) throw std::out_of_range("index out of range");
+    return at<K>(0, i);
+  }
+
+  void set(int i, const T& x) {
+    if (i < 0 || i >= total_size) throw std::out_of_range("index out of range");
+    at<K>(0, i) = x;
+  }
+
+  void add(int i, const T& x) {
+    if (i < 0 || i > total_size) throw std::out_of_range("index out of range");
+    if (static_cast<std::size_t>(total_size) == cap(K)) relayout(lg + 1);
+    insert_within<K>(0, i, x, total_size);
+    ++total_size;
+  }
+
+  T remove(int i) {
+    if (i < 0 || i >= total_size) throw std::out_of_range("index out of range");
+    T val = remove_within<K>(0, i, total_size - 1, T());
+    --total_size;
+    if (lg > 2 && static_cast<std::size_t>(total_size) <= cap(K) >> (K + 1)) relayout(lg - 1);
+    return val;
+  }
+
+  int size() const {
+    return total_size;
+  }
+
+  bool empty() const {
+    return total_size == 0;
+  }
+
+  int fanout() const {
+    return 1 << lg;
+  }
+};
+
 #include <iostream>
 #include <chrono>
 #include <cassert>
+#include <random>
+#include <string>
 
 // Test framework
 void test_basic_operations() {
@@ -158,6 +1213,360 @@ void test_edge_cases() {
     std::cout << std::endl;
 }
 
+void test_insert_range() {
+    std::cout << "\nTesting insertRange...\n";
+    Treque<int> tq;
+    std::vector<int> ref;
+
+    std::vector<int> empty;
+    tq.insertRange(0, empty.begin(), empty.end());
+    assert(tq.empty());
+
+    std::vector<int> chunk;
+    for (int i = 0; i < 40; ++i) chunk.push_back(i);
+    tq.insertRange(0, chunk.begin(), chunk.end());            // into empty
+    ref.insert(ref.begin(), chunk.begin(), chunk.end());
+    tq.insertRange(tq.size(), chunk.begin(), chunk.begin() + 5); // at back
+    ref.insert(ref.end(), chunk.begin(), chunk.begin() + 5);
+    tq.insertRange(17, chunk.rbegin(), chunk.rend());        // mid-block split
+    ref.insert(ref.begin() + 17, chunk.rbegin(), chunk.rend());
+    tq.add(3, -1);
+    ref.insert(ref.begin() + 3, -1);
+
+    // Large splice forces exactly one rebalance to a bigger block size.
+    std::vector<int> big(5000);
+    for (int i = 0; i < 5000; ++i) big[i] = 1000 + i;
+    tq.insertRange(50, big.begin(), big.end());
+    ref.insert(ref.begin() + 50, big.begin(), big.end());
+    tq.remove(60);
+    ref.erase(ref.begin() + 60);
+
+    bool correct = tq.size() == static_cast<int>(ref.size());
+    for (int i = 0; correct && i < tq.size(); ++i) {
+        correct = tq.get(i) == ref[i];
+    }
+    std::cout << "insertRange test: " << (correct ? "PASSED" : "FAILED") << std::endl;
+    assert(correct);
+
+    try {
+        tq.insertRange(tq.size() + 1, chunk.begin(), chunk.end());
+        assert(false);
+    } catch (const std::out_of_range&) {
+        std::cout << "Out of range insertRange rejected\n";
+    }
+}
+
+void test_batched_access() {
+    std::cout << "\nTesting get_many/set_many...\n";
+    Treque<int> tq;
+    std::vector<int> ref(3000);
+    for (int i = 0; i < 3000; ++i) ref[i] = i;
+    tq.insertRange(0, ref.begin(), ref.end());
+    tq.remove(10);  // leave an uneven block behind
+    ref.erase(ref.begin() + 10);
+
+    std::mt19937 rng(7);
+    std::vector<int> indices(500);
+    for (int& i : indices) i = static_cast<int>(rng() % ref.size());
+    std::vector<int> out;
+    tq.get_many(indices, out);
+    bool correct = out.size() == indices.size();
+    for (std::size_t k = 0; correct && k < indices.size(); ++k) {
+        correct = out[k] == ref[indices[k]];
+    }
+
+    std::vector<int> values(indices.size());
+    for (std::size_t k = 0; k < values.size(); ++k) {
+        values[k] = -static_cast<int>(k);
+        ref[indices[k]] = values[k];  // later duplicates overwrite earlier ones
+    }
+    tq.set_many(indices, values);
+    for (int i = 0; correct && i < tq.size(); ++i) correct = tq.get(i) == ref[i];
+    std::cout << "Batched access test: " << (correct ? "PASSED" : "FAILED") << std::endl;
+    assert(correct);
+
+    try {
+        tq.get_many({0, tq.size()}, out);
+        assert(false);
+    } catch (const std::out_of_range&) {
+        std::cout << "Out of range batch rejected\n";
+    }
+}
+
+void test_reverse() {
+    std::cout << "\nTesting reverse...\n";
+    Treque<int> tq;
+    std::vector<int> ref;
+    for (int i = 0; i < 500; ++i) {
+        tq.add(i, i);
+        ref.push_back(i);
+    }
+    std::mt19937 rng(9);
+    bool correct = true;
+    for (int step = 0; step < 3000 && correct; ++step) {
+        int n = static_cast<int>(ref.size());
+        int a = static_cast<int>(rng() % (n + 1));
+        int b = static_cast<int>(rng() % (n + 1));
+        if (a > b) std::swap(a, b);
+        switch (rng() % 6) {
+        case 0:
+        case 1:
+            tq.reverse(a, b);
+            std::reverse(ref.begin() + a, ref.begin() + b);
+            break;
+        case 2:
+            tq.add(a, -step);
+            ref.insert(ref.begin() + a, -step);
+            break;
+        case 3:
+            if (a < n) {
+                correct = tq.remove(a) == ref[a];
+                ref.erase(ref.begin() + a);
+            }
+            break;
+        case 4:
+            if (a < n) {
+                tq.set(a, step);
+                ref[a] = step;
+            }
+            break;
+        default: {
+            std::vector<int> chunk(ref.begin(), ref.begin() + std::min(b - a, 20));
+            tq.insertRange(a, chunk.begin(), chunk.end());
+            ref.insert(ref.begin() + a, chunk.begin(), chunk.end());
+            break;
+        }
+        }
+    }
+    correct = correct && tq.size() == static_cast<int>(ref.size());
+    std::vector<int> indices(ref.size()), out;
+    for (int i = 0; i < static_cast<int>(indices.size()); ++i) indices[i] = i;
+    tq.get_many(indices, out);
+    correct = correct && out == ref;
+    for (int i = 0; correct && i < tq.size(); ++i) correct = tq.get(i) == ref[i];
+    std::cout << "Reverse test: " << (correct ? "PASSED" : "FAILED") << std::endl;
+    assert(correct);
+}
+
+void test_edit_batch() {
+    std::cout << "\nTesting EditBatch...\n";
+    Treque<int> tq;
+    std::vector<int> ref(4000);
+    for (int i = 0; i < 4000; ++i) ref[i] = i;
+    tq.insertRange(0, ref.begin(), ref.end());
+    tq.reverse(100, 900);  // include flipped blocks in the sweep
+    std::reverse(ref.begin() + 100, ref.begin() + 900);
+
+    std::mt19937 rng(21);
+    bool correct = true;
+    for (int round = 0; round < 20 && correct; ++round) {
+        int n = static_cast<int>(ref.size());
+        Treque<int>::EditBatch batch;
+        std::vector<std::vector<int>> before(n + 1);
+        std::vector<char> removed(n, 0);
+        int edits = round % 2 == 0 ? 50 : 2000;
+        for (int e = 0; e < edits; ++e) {
+            if (rng() % 3 == 0) {
+                int i = static_cast<int>(rng() % n);
+                if (removed[i]) continue;
+                removed[i] = 1;
+                batch.remove(i);
+            } else {
+                int i = static_cast<int>(rng() % (n + 1));
+                int x = 100000 * (round + 1) + e;
+                batch.add(i, x);
+                before[i].push_back(x);
+            }
+        }
+        std::vector<int> expected;
+        for (int i = 0; i <= n; ++i) {
+            expected.insert(expected.end(), before[i].begin(), before[i].end());
+            if (i < n && !removed[i]) expected.push_back(ref[i]);
+        }
+        tq.apply(batch);
+        ref = expected;
+        correct = batch.empty() && tq.size() == static_cast<int>(ref.size());
+        for (int i = 0; correct && i < tq.size(); ++i) correct = tq.get(i) == ref[i];
+    }
+    std::cout << "EditBatch test: " << (correct ? "PASSED" : "FAILED") << std::endl;
+    assert(correct);
+
+    Treque<int>::EditBatch bad;
+    bad.remove(1);
+    bad.remove(1);
+    try {
+        tq.apply(bad);
+        assert(false);
+    } catch (const std::invalid_argument&) {
+        std::cout << "Duplicate removal rejected\n";
+    }
+}
+
+void test_fenwick_layout() {
+    std::cout << "\nTesting Fenwick-indexed layout...\n";
+    FenwickTreque<int> ft;
+    std::vector<int> ref;
+    std::mt19937 rng(3);
+    bool correct = true;
+    for (int step = 0; step < 20000; ++step) {
+        int op = static_cast<int>(rng() % 10);
+        if (op < 6 || ref.empty()) {
+            int i = static_cast<int>(rng() % (ref.size() + 1));
+            ft.add(i, step);
+            ref.insert(ref.begin() + i, step);
+        } else if (op < 9) {
+            int i = static_cast<int>(rng() % ref.size());
+            correct = correct && ft.remove(i) == ref[i];
+            ref.erase(ref.begin() + i);
+        } else {
+            int i = static_cast<int>(rng() % ref.size());
+            ft.set(i, -step);
+            ref[i] = -step;
+        }
+    }
+    correct = correct && ft.size() == static_cast<int>(ref.size());
+    for (int i = 0; correct && i < ft.size(); ++i) correct = ft.get(i) == ref[i];
+    while (correct && !ft.empty()) correct = ft.remove(0) == ref[ref.size() - ft.size() - 1];
+    std::cout << "Fenwick layout test: " << (correct ? "PASSED" : "FAILED")
+              << " (" << ft.block_count() << " blocks left)" << std::endl;
+    assert(correct && ft.block_count() == 0);
+}
+
+void test_packed_memory_array() {
+    std::cout << "\nTesting PackedMemoryArray...\n";
+    PackedMemoryArray<int> pma;
+    std::vector<int> ref;
+    std::mt19937 rng(13);
+    bool correct = true;
+    int peak_capacity = 0;
+    for (int step = 0; step < 30000 && correct; ++step) {
+        int op = static_cast<int>(rng() % 10);
+        // Grow for the first half, then drain to exercise shrinking
+        int grow = step < 15000 ? 6 : 3;
+        peak_capacity = std::max(peak_capacity, pma.capacity());
+        if (step % 5000 == 0) {
+            for (int i = 0; correct && i < pma.size(); ++i) correct = pma.get(i) == ref[i];
+        }
+        if (op < grow || ref.empty()) {
+            int i = static_cast<int>(rng() % (ref.size() + 1));
+            pma.add(i, step);
+            ref.insert(ref.begin() + i, step);
+        } else if (op < 9) {
+            int i = static_cast<int>(rng() % ref.size());
+            correct = pma.remove(i) == ref[i];
+            ref.erase(ref.begin() + i);
+        } else {
+            int i = static_cast<int>(rng() % ref.size());
+            pma.set(i, -step);
+            ref[i] = -step;
+        }
+    }
+    correct = correct && pma.size() == static_cast<int>(ref.size());
+    for (int i = 0; correct && i < pma.size(); ++i) correct = pma.get(i) == ref[i];
+    std::vector<int> scanned;
+    int mid = pma.size() / 2;
+    pma.scan(mid, pma.size(), [&](int x) { scanned.push_back(x); });
+    correct = correct && scanned == std::vector<int>(ref.begin() + mid, ref.end());
+    std::cout << "PackedMemoryArray test: " << (correct ? "PASSED" : "FAILED")
+              << " (" << pma.size() << " elements in " << pma.capacity() << " slots, peak "
+              << peak_capacity << ")" << std::endl;
+    assert(correct);
+}
+
+template<int K>
+bool check_tiered_vector(int steps) {
+    TieredVector<int, K> tv;
+    std::vector<int> ref;
+    std::mt19937 rng(19 + K);
+    bool correct = true;
+    for (int step = 0; step < steps && correct; ++step) {
+        int op = static_cast<int>(rng() % 10);
+        int grow = step < steps / 2 ? 6 : 3;
+        if (op < grow || ref.empty()) {
+            int i = static_cast<int>(rng() % (ref.size() + 1));
+            tv.add(i, step);
+            ref.insert(ref.begin() + i, step);
+        } else if (op < 9) {
+            int i = static_cast<int>(rng() % ref.size());
+            correct = tv.remove(i) == ref[i];
+            ref.erase(ref.begin() + i);
+        } else {
+            int i = static_cast<int>(rng() % ref.size());
+            tv.set(i, -step);
+            ref[i] = -step;
+        }
+        if (step % 1000 == 0 || step == steps / 2) {
+            correct = correct && tv.size() == static_cast<int>(ref.size());
+            for (int i = 0; correct && i < tv.size(); ++i) correct = tv.get(i) == ref[i];
+        }
+    }
+    return correct;
+}
+
+void test_tiered_vector() {
+    std::cout << "\nTesting TieredVector...\n";
+    bool correct = check_tiered_vector<1>(3000) && check_tiered_vector<2>(20000) &&
+                   check_tiered_vector<3>(20000) && check_tiered_vector<4>(20000);
+    std::cout << "TieredVector test (k = 1..4): " << (correct ? "PASSED" : "FAILED") << std::endl;
+    assert(correct);
+}
+
+void test_concurrent_treque() {
+    std::cout << "\nTesting ConcurrentTreque...\n";
+    ConcurrentTreque<int> ct(64);
+    std::vector<int> ref;
+    std::mt19937 rng(5);
+    bool correct = true;
+    for (int step = 0; step < 5000; ++step) {
+        int op = static_cast<int>(rng() % 10);
+        if (op < 6 || ref.empty()) {
+            int i = static_cast<int>(rng() % (ref.size() + 1));
+            ct.add(i, step);
+            ref.insert(ref.begin() + i, step);
+        } else if (op < 8) {
+            int i = static_cast<int>(rng() % ref.size());
+            correct = correct && ct.remove(i) == ref[i];
+            ref.erase(ref.begin() + i);
+        } else {
+            int i = static_cast<int>(rng() % ref.size());
+            ct.set(i, -step);
+            ref[i] = -step;
+        }
+    }
+    for (int i = 0; correct && i < ct.size(); ++i) correct = ct.get(i) == ref[i];
+    std::cout << "Sequential ConcurrentTreque test: " << (correct ? "PASSED" : "FAILED") << std::endl;
+    assert(correct);
+
+    // Readers check get(i) == i while a writer keeps a -1 flickering in at
+    // the front and grows and shrinks the tail through several re-blocks.
+    const int n = 2000;
+    ConcurrentTreque<int> shared(64);
+    for (int i = 0; i < n; ++i) shared.add(i, i);
+    std::atomic<bool> done(false);
+    std::atomic<int> bad(0);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t) {
+        readers.emplace_back([&, t] {
+            std::mt19937 local(t);
+            while (!done.load()) {
+                int i = static_cast<int>(local() % n);
+                int v = shared.get(i);
+                if (v != i && v != i - 1) bad.fetch_add(1);
+            }
+        });
+    }
+    for (int round = 0; round < 2000; ++round) {
+        shared.add(0, -1);
+        shared.remove(0);
+        shared.add(shared.size(), round);
+        if (round % 3 == 0) shared.remove(shared.size() - 1);
+    }
+    done.store(true);
+    for (auto& th : readers) th.join();
+    std::cout << "Concurrent read/write test: " << (bad.load() == 0 ? "PASSED" : "FAILED") << std::endl;
+    assert(bad.load() == 0);
+}
+
 void test_performance() {
     std::cout << "\nTesting performance characteristics...\n";
     Treque<int> tq;
@@ -188,6 +1597,98 @@ void test_performance() {
     std::cout << "Final treque size: " << tq.size() << std::endl;
 }
 
+// One insertRange into the middle against the same elements added one by
+// one at consecutive middle positions.
+void bench_insert_range() {
+    std::cout << "\ninsertRange vs add...\n";
+    const int n = 1000;
+    Treque<int> tq;
+    for (int i = 0; i < n; ++i) tq.add(i / 2, i);
+    std::vector<int> batch(n);
+    for (int i = 0; i < n; ++i) batch[i] = i;
+
+    Treque<int> one_by_one = tq;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < n; ++i) {
+        one_by_one.add(tq.size() / 2 + i, batch[i]);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    std::cout << "Time for " << n << " adds into the middle: " << duration.count() << " microseconds\n";
+
+    start = std::chrono::high_resolution_clock::now();
+    tq.insertRange(tq.size() / 2, batch.begin(), batch.end());
+    end = std::chrono::high_resolution_clock::now();
+    duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    std::cout << "Time for one insertRange of " << n << ": " << duration.count() << " microseconds\n";
+}
+
+// Batched gather against a get() loop over the same random indices.
+void bench_get_many() {
+    std::cout << "\nget_many vs get...\n";
+    Treque<int> large;
+    std::vector<int> items(200000);
+    for (int i = 0; i < static_cast<int>(items.size()); ++i) items[i] = i;
+    large.insertRange(0, items.begin(), items.end());
+    std::mt19937 rng(1);
+    std::vector<int> indices(10000);
+    for (int& i : indices) i = static_cast<int>(rng() % large.size());
+    long long loop_sum = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i : indices) loop_sum += large.get(i);
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    std::cout << "Time for " << indices.size() << " get() calls: " << duration.count() << " microseconds\n";
+    std::vector<int> gathered;
+    start = std::chrono::high_resolution_clock::now();
+    large.get_many(indices, gathered);
+    end = std::chrono::high_resolution_clock::now();
+    duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    long long batch_sum = 0;
+    for (int x : gathered) batch_sum += x;
+    std::cout << "Time for one get_many of " << indices.size() << ": " << duration.count()
+              << " microseconds (sums " << (loop_sum == batch_sum ? "match" : "differ") << ")\n";
+}
+
+// Reversal touches whole blocks lazily, so it should grow like sqrt(n).
+void bench_reverse() {
+    std::cout << "\nreverse scaling...\n";
+    for (int size : {10000, 1000000}) {
+        Treque<int> rev;
+        std::vector<int> fill(size, 1);
+        rev.insertRange(0, fill.begin(), fill.end());
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int r = 0; r < 100; ++r) rev.reverse(r + 1, size - r - 1);
+        auto end = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+        std::cout << "Time for 100 reversals of ~" << size << " elements: " << duration.count() << " microseconds\n";
+    }
+}
+
+// Scattered end-of-tick edits: one add() each vs a single EditBatch.
+void bench_edit_batch() {
+    std::cout << "\nEditBatch vs scattered add...\n";
+    std::mt19937 rng(1);
+    Treque<int> single, batched;
+    std::vector<int> base(200000, 0);
+    single.insertRange(0, base.begin(), base.end());
+    batched.insertRange(0, base.begin(), base.end());
+    std::vector<int> positions(5000);
+    for (int& pos : positions) pos = static_cast<int>(rng() % base.size());
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int pos : positions) single.add(pos, 1);
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    std::cout << "Time for " << positions.size() << " scattered add() calls: " << duration.count() << " microseconds\n";
+    Treque<int>::EditBatch batch;
+    for (int pos : positions) batch.add(pos, 1);
+    start = std::chrono::high_resolution_clock::now();
+    batched.apply(batch);
+    end = std::chrono::high_resolution_clock::now();
+    duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+    std::cout << "Time for one EditBatch of " << positions.size() << " inserts: " << duration.count() << " microseconds\n";
+}
+
 void test_correctness() {
     std::cout << "\nTesting correctness with larger dataset...\n";
     Treque<int> tq;
@@ -229,6 +1730,241 @@ void test_correctness() {
     std::cout << "Set operation test: " << (correct ? "PASSED" : "FAILED") << std::endl;
 }
 
+struct Payload64 {
+    double v[8];
+    Payload64(int x = 0) { for (double& d : v) d = x; }
+    bool operator==(const Payload64& o) const { return v[0] == o.v[0]; }
+};
+
+void test_block_size_tuning() {
+    std::cout << "\nTesting block size tuning...\n";
+    Treque<int> small_ints;
+    Treque<Payload64> wide;
+    std::vector<int> items(1 << 16);
+    for (int i = 0; i < static_cast<int>(items.size()); ++i) items[i] = i;
+    small_ints.insertRange(0, items.begin(), items.end());
+    wide.insertRange(0, items.begin(), items.end());
+    std::cout << "Auto block size for int: " << small_ints.get_block_size()
+              << ", for 64-byte payload: " << wide.get_block_size() << std::endl;
+    assert(small_ints.get_block_size() == 1024);  // sqrt(65536 * 64 / 4)
+    assert(wide.get_block_size() == 256);         // sqrt(65536 * 64 / 64)
+
+    wide.set_cache_target(4096);
+    assert(wide.get_block_size() == 64);          // 4 KiB / 64 bytes
+    small_ints.set_block_size(100);
+    assert(small_ints.get_block_size() == 100);
+    small_ints.set_block_size(0);
+    assert(small_ints.get_block_size() == 1024);
+
+    bool correct = true;
+    for (int i = 0; correct && i < small_ints.size(); i += 97) {
+        correct = small_ints.get(i) == i && wide.get(i) == Payload64(i);
+    }
+
+    // Appending reuses the tail block instead of opening one per element
+    Treque<int> appended;
+    appended.set_block_size(32);
+    for (int i = 0; i < 1000; ++i) appended.add(i, i);
+    for (int i = 0; correct && i < 1000; ++i) correct = appended.get(i) == i;
+    std::cout << "Block size tuning test: " << (correct ? "PASSED" : "FAILED") << std::endl;
+    assert(correct);
+}
+
+// Sweeps fixed block sizes over a get/add mix and reports the fastest one
+// next to the size auto-tuning would pick.
+template<typename T>
+void bench_block_sizes(const char* type_name, int n, int ops, int get_percent) {
+    std::vector<T> items(n);
+    for (int i = 0; i < n; ++i) items[i] = T(i);
+    std::mt19937 rng(42);
+
+    Treque<T> tuned;
+    tuned.insertRange(0, items.begin(), items.end());
+
+    int best_size = 0;
+    long long best_us = -1;
+    for (int b = 16; b <= 4096; b *= 2) {
+        Treque<T> tq;
+        tq.set_block_size(b);
+        tq.insertRange(0, items.begin(), items.end());
+        std::uniform_int_distribution<int> pct(0, 99);
+        auto start = std::chrono::high_resolution_clock::now();
+        T sink{};
+        for (int op = 0; op < ops; ++op) {
+            if (pct(rng) < get_percent) {
+                sink = tq.get(static_cast<int>(rng() % tq.size()));
+            } else {
+                tq.add(static_cast<int>(rng() % (tq.size() + 1)), sink);
+            }
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        long long us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        if (best_us < 0 || us < best_us) {
+            best_us = us;
+            best_size = b;
+        }
+    }
+    std::cout << type_name << " (" << get_percent << "% get): best block size "
+              << best_size << " (" << best_us << " us), auto-tuned "
+              << tuned.get_block_size() << std::endl;
+}
+
+void bench_block_size_sweep() {
+    std::cout << "\nBlock size sweep (n = 50000, 20000 ops)...\n";
+    for (int get_percent : {90, 50}) {
+        bench_block_sizes<int>("int", 50000, 20000, get_percent);
+        bench_block_sizes<double>("double", 50000, 20000, get_percent);
+        bench_block_sizes<Payload64>("Payload64", 50000, 20000, get_percent);
+    }
+}
+
+// Runs the same random get/add workload against either layout.
+template<typename Seq>
+long long time_layout(int n, int ops, int get_percent) {
+    Seq seq;
+    for (int i = 0; i < n; ++i) seq.add(i, i);
+    std::mt19937 rng(11);
+    long long sink = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int op = 0; op < ops; ++op) {
+        if (static_cast<int>(rng() % 100) < get_percent) {
+            sink += seq.get(static_cast<int>(rng() % seq.size()));
+        } else {
+            seq.add(static_cast<int>(rng() % (seq.size() + 1)), op);
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    if (sink == -1) std::cout << "";
+    return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+void bench_layouts() {
+    std::cout << "\nFixed blocks vs Fenwick-indexed blocks (20000 ops)...\n";
+    for (int n : {10000, 100000, 1000000}) {
+        for (int get_percent : {90, 50}) {
+            std::cout << "n = " << n << ", " << get_percent << "% get: fixed "
+                      << time_layout<Treque<int>>(n, 20000, get_percent) << " us, fenwick "
+                      << time_layout<FenwickTreque<int>>(n, 20000, get_percent) << " us\n";
+        }
+    }
+}
+
+// Head-to-head: random inserts, random gets and one full in-order scan.
+// Treque scans through get_many() over every index, its fastest path.
+void bench_pma_vs_treque() {
+    std::cout << "\nPackedMemoryArray vs Treque...\n";
+    for (int n : {100000, 1000000}) {
+        std::mt19937 rng(17);
+        std::vector<int> positions(n), probes(n);
+        for (int i = 0; i < n; ++i) {
+            positions[i] = static_cast<int>(rng() % (i + 1));
+            probes[i] = static_cast<int>(rng() % n);
+        }
+        Treque<int> tq;
+        PackedMemoryArray<int> pma;
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < n; ++i) tq.add(positions[i], i);
+        auto mid = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < n; ++i) pma.add(positions[i], i);
+        auto end = std::chrono::high_resolution_clock::now();
+        std::cout << "n = " << n << " random inserts: treque "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(mid - start).count() << " ms, pma "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(end - mid).count() << " ms\n";
+
+        long long a = 0, b = 0;
+        start = std::chrono::high_resolution_clock::now();
+        for (int i : probes) a += tq.get(i);
+        mid = std::chrono::high_resolution_clock::now();
+        for (int i : probes) b += pma.get(i);
+        end = std::chrono::high_resolution_clock::now();
+        std::cout << "n = " << n << " random gets: treque "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(mid - start).count() << " ms, pma "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(end - mid).count() << " ms"
+                  << (a == b ? "" : " (MISMATCH)") << "\n";
+
+        std::vector<int> all(n), out;
+        for (int i = 0; i < n; ++i) all[i] = i;
+        a = b = 0;
+        start = std::chrono::high_resolution_clock::now();
+        tq.get_many(all, out);
+        for (int x : out) a += x;
+        mid = std::chrono::high_resolution_clock::now();
+        pma.scan(0, n, [&](int x) { b += x; });
+        end = std::chrono::high_resolution_clock::now();
+        std::cout << "n = " << n << " full scan: treque "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(mid - start).count() << " us, pma "
+                  << std::chrono::duration_cast<std::chrono::microseconds>(end - mid).count() << " us"
+                  << (a == b ? "" : " (MISMATCH)") << "\n";
+    }
+}
+
+// Random inserts then random gets, so the depth can be picked per size.
+template<typename Seq>
+void time_sequence(const char* name, int n) {
+    std::mt19937 rng(23);
+    Seq seq;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < n; ++i) seq.add(static_cast<int>(rng() % (i + 1)), i);
+    auto mid = std::chrono::high_resolution_clock::now();
+    long long sink = 0;
+    for (int i = 0; i < n; ++i) sink += seq.get(static_cast<int>(rng() % n));
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "  " << name << ": inserts "
+              << std::chrono::duration<double, std::nano>(mid - start).count() / n << " ns/op, gets "
+              << std::chrono::duration<double, std::nano>(end - mid).count() / n << " ns/op"
+              << (sink < 0 ? " (overflow)" : "") << "\n";
+}
+
+void bench_tiered_vectors() {
+    std::cout << "\nTieredVector depth sweep...\n";
+    for (int n : {10000, 100000, 1000000}) {
+        std::cout << "n = " << n << "\n";
+        time_sequence<Treque<int>>("Treque", n);
+        time_sequence<TieredVector<int, 2>>("TieredVector<2>", n);
+        time_sequence<TieredVector<int, 3>>("TieredVector<3>", n);
+        time_sequence<TieredVector<int, 4>>("TieredVector<4>", n);
+    }
+}
+
+// Mixed throughput: every thread issues `ops` operations, write_percent of
+// them edits (a set, or an add followed by a remove) and the rest gets.
+void bench_concurrent_treque() {
+    std::cout << "\nConcurrentTreque mixed throughput (n = 100000, 5% writes)...\n";
+    const int n = 100000;
+    const int ops = 100000;
+    const int write_percent = 5;
+    for (int threads : {1, 2, 4, 8}) {
+        ConcurrentTreque<int> ct;
+        for (int i = 0; i < n; ++i) ct.add(i, i);
+        std::vector<std::thread> pool;
+        std::atomic<long long> sink(0);
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int t = 0; t < threads; ++t) {
+            pool.emplace_back([&, t] {
+                std::mt19937 rng(t + 1);
+                long long local = 0;
+                for (int op = 0; op < ops; ++op) {
+                    int i = static_cast<int>(rng() % n);
+                    if (static_cast<int>(rng() % 100) >= write_percent) {
+                        local += ct.get(i);
+                    } else if (op & 1) {
+                        ct.set(i, i);
+                    } else {
+                        ct.add(i, -1);
+                        ct.remove(i);
+                    }
+                }
+                sink.fetch_add(local);
+            });
+        }
+        for (auto& th : pool) th.join();
+        auto end = std::chrono::high_resolution_clock::now();
+        double secs = std::chrono::duration<double>(end - start).count();
+        std::cout << threads << " thread(s): " << (threads * ops / secs / 1e6) << " Mops/s\n";
+    }
+}
+
 int main() {
     std::cout << "=== Treque Implementation Tests ===\n";
     
@@ -236,7 +1972,25 @@ int main() {
         test_basic_operations();
         test_edge_cases();
         test_correctness();
+        test_insert_range();
+        test_block_size_tuning();
+        test_batched_access();
+        test_reverse();
+        test_edit_batch();
+        test_fenwick_layout();
+        test_packed_memory_array();
+        test_tiered_vector();
+        test_concurrent_treque();
         test_performance();
+        bench_insert_range();
+        bench_get_many();
+        bench_reverse();
+        bench_edit_batch();
+        bench_block_size_sweep();
+        bench_layouts();
+        bench_pma_vs_treque();
+        bench_tiered_vectors();
+        bench_concurrent_treque();
         
         std::cout << "\n=== All Tests Completed ===\n";
         
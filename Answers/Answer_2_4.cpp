@@ -1,81 +1,571 @@
 #include <utility>
 #include <vector>
+#if __has_include(<version>)
+#include <version>
+#endif
 #include <iostream>
+#include <iomanip>
 #include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <numeric>
+#include <random>
+#if __has_include(<span>)
+#include <span>
+#endif
+#include <string>
+#include <thread>
+#include <type_traits>
 
- 
+// Define ARRAY_ROTATOR_NO_SIMD to force the scalar reversal kernel.
+#if !defined(ARRAY_ROTATOR_NO_SIMD) && defined(__AVX2__)
+#include <immintrin.h>
+#define ARRAY_ROTATOR_SIMD_BYTES 32
+#elif !defined(ARRAY_ROTATOR_NO_SIMD) && defined(__SSE2__)
+#include <emmintrin.h>
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+#define ARRAY_ROTATOR_SIMD_BYTES 16
+#else
+#define ARRAY_ROTATOR_SIMD_BYTES 0
+#endif
+
+// Reverses the order of the S-byte lanes of one vector register.
+#if ARRAY_ROTATOR_SIMD_BYTES == 32
+using simd_reg = __m256i;
+
+inline simd_reg simd_load(const unsigned char* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+inline void simd_store(unsigned char* p, simd_reg x) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), x); }
+
+template<size_t S>
+inline simd_reg simd_reverse(simd_reg x) {
+    if constexpr (S == 8) {
+        return _mm256_permute4x64_epi64(x, 0x1B);
+    } else if constexpr (S == 4) {
+        return _mm256_permutevar8x32_epi32(x, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+    } else {
+        // Reverse within each 128-bit lane, then swap the lanes.
+        const __m256i mask = S == 2
+            ? _mm256_setr_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1,
+                               14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1)
+            : _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                               15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+        return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(x, mask), 0x4E);
+    }
+}
+#elif ARRAY_ROTATOR_SIMD_BYTES == 16
+using simd_reg = __m128i;
+
+inline simd_reg simd_load(const unsigned char* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+inline void simd_store(unsigned char* p, simd_reg x) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), x); }
+
+template<size_t S>
+inline simd_reg simd_reverse(simd_reg x) {
+    if constexpr (S == 8) {
+        return _mm_shuffle_epi32(x, 0x4E);
+    } else if constexpr (S == 4) {
+        return _mm_shuffle_epi32(x, 0x1B);
+    } else {
+#ifdef __SSSE3__
+        const __m128i mask = S == 2
+            ? _mm_setr_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1)
+            : _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+        return _mm_shuffle_epi8(x, mask);
+#else
+        // SSE2 only: reverse the 16-bit words, then, for bytes, swap the
+        // two bytes inside every word.
+        x = _mm_shuffle_epi32(_mm_shufflehi_epi16(_mm_shufflelo_epi16(x, 0x1B), 0x1B), 0x4E);
+        if constexpr (S == 1) {
+            x = _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+        }
+        return x;
+#endif
+    }
+}
+#endif
+
+// Swaps first[i] with last[-1 - i] for i < pairs, i.e. the outer 2 * pairs
+// elements of a reversal of [first, last); pairs must be at most half the
+// length. For trivially copyable elements of 1, 2, 4 or 8 bytes it loads
+// one vector from each end, reverses both in registers and stores them
+// swapped, so the pass runs at memory bandwidth; the leftover pairs, and
+// all other types, are done one swap at a time.
+template<typename T>
+void swap_mirrored(T* first, T* last, size_t pairs) {
+#if ARRAY_ROTATOR_SIMD_BYTES > 0
+    constexpr size_t S = sizeof(T);
+    if constexpr (std::is_trivially_copyable<T>::value && (S == 1 || S == 2 || S == 4 || S == 8)) {
+        constexpr size_t W = ARRAY_ROTATOR_SIMD_BYTES;
+        unsigned char* lo = reinterpret_cast<unsigned char*>(first);
+        unsigned char* hi = reinterpret_cast<unsigned char*>(last);
+        for (; pairs >= W / S; pairs -= W / S) {
+            hi -= W;
+            simd_reg a = simd_load(lo);
+            simd_reg b = simd_load(hi);
+            simd_store(lo, simd_reverse<S>(b));
+            simd_store(hi, simd_reverse<S>(a));
+            lo += W;
+        }
+        first = reinterpret_cast<T*>(lo);
+        last = reinterpret_cast<T*>(hi);
+    }
+#endif
+    for (; pairs > 0; --pairs) {
+        --last;
+        using std::swap;
+        swap(*first, *last);
+        ++first;
+    }
+}
+
+// Reverses [first, last) with the kernel above.
+template<typename T>
+void reverse_swap(T* first, T* last) {
+    swap_mirrored(first, last, static_cast<size_t>(last - first) / 2);
+}
+
+// Whether moving a T is just copying its bytes, so that rotate() can
+// trade extra moves for sequential access. Specialize for wrappers that
+// should be treated like the type they wrap.
+template<typename T>
+struct cheap_to_move : std::is_trivially_copyable<T> {};
+
+/**
+ * A random-access view of count elements spaced stride apart, starting at
+ * base: a matrix column, every other sample of an interleaved buffer, and
+ * so on. Its iterators work with the iterator overloads of ArrayRotator,
+ * which then rotate the viewed elements in place. A negative stride walks
+ * backwards.
+ */
+template<typename T>
+class StridedView {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_cv_t<T>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator() = default;
+        iterator(T* base, std::ptrdiff_t i, std::ptrdiff_t stride) : base(base), i(i), stride(stride) {}
+
+        reference operator*() const { return base[i * stride]; }
+        pointer operator->() const { return &**this; }
+        reference operator[](difference_type k) const { return base[(i + k) * stride]; }
+
+        iterator& operator++() { ++i; return *this; }
+        iterator operator++(int) { iterator old = *this; ++i; return old; }
+        iterator& operator--() { --i; return *this; }
+        iterator operator--(int) { iterator old = *this; --i; return old; }
+        iterator& operator+=(difference_type k) { i += k; return *this; }
+        iterator& operator-=(difference_type k) { i -= k; return *this; }
+        friend iterator operator+(iterator it, difference_type k) { return it += k; }
+        friend iterator operator+(difference_type k, iterator it) { return it += k; }
+        friend iterator operator-(iterator it, difference_type k) { return it -= k; }
+        friend difference_type operator-(const iterator& a, const iterator& b) { return a.i - b.i; }
+
+        friend bool operator==(const iterator& a, const iterator& b) { return a.i == b.i; }
+        friend bool operator!=(const iterator& a, const iterator& b) { return a.i != b.i; }
+        friend bool operator<(const iterator& a, const iterator& b) { return a.i < b.i; }
+        friend bool operator>(const iterator& a, const iterator& b) { return a.i > b.i; }
+        friend bool operator<=(const iterator& a, const iterator& b) { return a.i <= b.i; }
+        friend bool operator>=(const iterator& a, const iterator& b) { return a.i >= b.i; }
+
+    private:
+        // An index rather than a moving pointer, so that end() never forms
+        // an address past the underlying buffer.
+        T* base = nullptr;
+        std::ptrdiff_t i = 0;
+        std::ptrdiff_t stride = 1;
+    };
+
+    StridedView(T* base, size_t count, std::ptrdiff_t stride) : base(base), count(count), stride(stride) {}
+
+    iterator begin() const { return iterator(base, 0, stride); }
+    iterator end() const { return iterator(base, static_cast<std::ptrdiff_t>(count), stride); }
+
+    T& operator[](size_t i) const { return base[static_cast<std::ptrdiff_t>(i) * stride]; }
+    size_t size() const { return count; }
+
+private:
+    T* base;
+    size_t count;
+    std::ptrdiff_t stride;
+};
+
+// Rotations are right rotations: after rotate(a, r), the element that was
+// at index i is at index (i + r) mod n. Negative r rotates left.
+//
+// Every method takes a std::vector, a pair of random-access iterators
+// (which includes plain pointers and StridedView iterators, e.g. for a
+// matrix column) or, with C++20, a std::span; rotate_parallel needs
+// contiguous storage and takes a vector, pointers or a span.
 template<typename T>
 class ArrayRotator {
 public:
-   static void rotate_simple(std::vector<T>& a, int r) {
-        if (a.empty()) return;
-        
-        int n = a.size();
-        r = normalize_rotation(r, n);
+   template<typename It>
+   static void rotate_simple(It first, It last, long long r) {
+        check_iterator<It>();
+        size_t n = static_cast<size_t>(last - first);
+        if (n == 0) return;
+
+        size_t k = normalize_rotation(r, n);
         std::vector<T> temp(n);
-        for (int i = 0; i < n; i++){
-        temp[(i + r) % n ] = a[i];
-    }
-    a = temp;
+        for (size_t i = 0; i < n; i++) {
+            temp[(i + k) % n] = std::move(first[i]);
+        }
+        std::move(temp.begin(), temp.end(), first);
    }
-    
-   static void rotate_reversal(std::vector<T>& a, int r) {
-        if (a.empty()) return;
-        
-        int n = a.size();
-        r = normalize_rotation(r, n);
-        
-        reverse_range(a, 0, n);
-        reverse_range(a, 0 , r);
-        reverse_range(a, r, n);
+
+   template<typename It>
+   static void rotate_reversal(It first, It last, long long r) {
+        check_iterator<It>();
+        size_t n = static_cast<size_t>(last - first);
+        if (n == 0) return;
+
+        size_t k = normalize_rotation(r, n);
+
+        reverse_range(first, 0, n);
+        reverse_range(first, 0, k);
+        reverse_range(first, k, n);
    }
-    
-   static void rotate_cyclic(std::vector<T>& a, int r) {
-        if (a.empty()) return;
-        
-        int n = a.size();
-        
-        r = normalize_rotation(r, n);
-        int g = gcd(n, r);
-        for (int start = 0; start < g; ++start) {
-
-        T temp = a[start];
-        int current = start;
-        
-        while (true) {
-        int next = (current + r) % n;
-       if (next == start) break; 
-        a[current] = a[next];
-          current = next;
-        }
-      a[current] = temp;
-    }
+
+   template<typename It>
+   static void rotate_cyclic(It first, It last, long long r) {
+        check_iterator<It>();
+        size_t n = static_cast<size_t>(last - first);
+        if (n == 0) return;
+
+        cyclic_rotate(first, n, normalize_rotation(r, n));
+   }
+
+   // Gries-Mills block swap: repeatedly swaps the shorter of the two parts
+   // into its final place with one sequential swap_ranges and continues on
+   // what is left, so every pass streams through contiguous memory. Once
+   // the shorter part fits in BUFFER_BYTES the rest is finished through a
+   // buffer, which avoids long runs of tiny swaps when n and r are coprime.
+   template<typename It>
+   static void rotate_block_swap(It first, It last, long long r) {
+        check_iterator<It>();
+        size_t n = static_cast<size_t>(last - first);
+        if (n == 0) return;
+
+        size_t k = normalize_rotation(r, n);
+        block_swap_rotate(first, n, k == 0 ? 0 : n - k);
    }
-    
+
+   // Picks the method from n, r and the element type:
+   // - a shift of at most BUFFER_BYTES worth of elements either way is
+   //   moved through a small buffer: one pass, n + min(k, n - k) moves;
+   // - types that are not trivially copyable, so that every move costs,
+   //   use cycle following while the array fits in CACHE_BYTES: it moves
+   //   each element once, and its strided access is free in cache;
+   // - everything else uses block swap, which only makes sequential passes.
+   template<typename It>
+   static void rotate(It first, It last, long long r) {
+        check_iterator<It>();
+        size_t n = static_cast<size_t>(last - first);
+        if (n == 0) return;
+
+        size_t k = normalize_rotation(r, n);
+        if (k == 0) return;
+        size_t shortSide = std::min(k, n - k);
+        if (shortSide * sizeof(T) <= BUFFER_BYTES) {
+            buffer_rotate(first, n, k);
+        } else if (!cheap_to_move<T>::value && n * sizeof(T) <= CACHE_BYTES) {
+            cyclic_rotate(first, n, k);
+        } else {
+            block_swap_rotate(first, n, n - k);
+        }
+   }
+
+   // Rotation by three reversals, each split into equal runs of mirrored
+   // pairs that threads swap independently; one join between the full
+   // reversal and the two partial ones. Every thread streams through two
+   // contiguous regions with the vector kernel, so the rotation scales
+   // until memory bandwidth runs out. Arrays under PARALLEL_MIN_BYTES are
+   // not worth the thread start-up and go to rotate().
+   static void rotate_parallel(T* first, T* last, long long r, unsigned threads = 0) {
+        size_t n = static_cast<size_t>(last - first);
+        if (n == 0) return;
+
+        size_t k = normalize_rotation(r, n);
+        if (k == 0) return;
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        if (threads == 1 || n * sizeof(T) < PARALLEL_MIN_BYTES) {
+            rotate(first, last, r);
+            return;
+        }
+
+        T* base = first;
+        // Pairs [0, n / 2) reverse the whole array; after that, pairs of
+        // [0, k) and of [k, n) are numbered one after the other.
+        parallel_pairs(n / 2, threads, [&](size_t from, size_t to) {
+            swap_mirrored(base + from, base + n - from, to - from);
+        });
+        size_t headPairs = k / 2;
+        parallel_pairs(headPairs + (n - k) / 2, threads, [&](size_t from, size_t to) {
+            if (from < headPairs) {
+                size_t end = std::min(to, headPairs);
+                swap_mirrored(base + from, base + k - from, end - from);
+                from = end;
+            }
+            if (from < to) {
+                size_t f = from - headPairs, t = to - headPairs;
+                swap_mirrored(base + k + f, base + n - f, t - f);
+            }
+        });
+   }
+
+   static void rotate_simple(std::vector<T>& a, long long r) { rotate_simple(a.begin(), a.end(), r); }
+   static void rotate_reversal(std::vector<T>& a, long long r) { rotate_reversal(a.begin(), a.end(), r); }
+   static void rotate_cyclic(std::vector<T>& a, long long r) { rotate_cyclic(a.begin(), a.end(), r); }
+   static void rotate_block_swap(std::vector<T>& a, long long r) { rotate_block_swap(a.begin(), a.end(), r); }
+   static void rotate(std::vector<T>& a, long long r) { rotate(a.begin(), a.end(), r); }
+   static void rotate_parallel(std::vector<T>& a, long long r, unsigned threads = 0) {
+        rotate_parallel(a.data(), a.data() + a.size(), r, threads);
+   }
+
+#ifdef __cpp_lib_span
+   static void rotate_simple(std::span<T> a, long long r) { rotate_simple(a.data(), a.data() + a.size(), r); }
+   static void rotate_reversal(std::span<T> a, long long r) { rotate_reversal(a.data(), a.data() + a.size(), r); }
+   static void rotate_cyclic(std::span<T> a, long long r) { rotate_cyclic(a.data(), a.data() + a.size(), r); }
+   static void rotate_block_swap(std::span<T> a, long long r) { rotate_block_swap(a.data(), a.data() + a.size(), r); }
+   static void rotate(std::span<T> a, long long r) { rotate(a.data(), a.data() + a.size(), r); }
+   static void rotate_parallel(std::span<T> a, long long r, unsigned threads = 0) {
+        rotate_parallel(a.data(), a.data() + a.size(), r, threads);
+   }
+#endif
+
+   static constexpr size_t BUFFER_BYTES = 4096;
+   static constexpr size_t PARALLEL_MIN_BYTES = 1 << 20;
+   static constexpr size_t CACHE_BYTES = 256 * 1024;
+
 private:
-    static int normalize_rotation(int r, int n) {
-        r = ((r % n) + n) %n;
-        return r; // placeholder
-    }
-    
-    static void reverse_range(std::vector<T>& a, int start, int end) {
-      while (start < end) {
-      std::swap(a[start], a[end]);
-      start++;
-      end--;
-      
-      }
-    }
-    
-    static int gcd(int a, int b) {
-      while (b != 0) {
-      int temp = b;
-      b = a % b;
-      a = temp;
-      
-      }
-        return a; // placeholder
+    template<typename It>
+    static void check_iterator() {
+        static_assert(std::is_same<typename std::iterator_traits<It>::value_type, T>::value,
+                      "iterator must point to T");
+        static_assert(std::is_base_of<std::random_access_iterator_tag,
+                                      typename std::iterator_traits<It>::iterator_category>::value,
+                      "rotation needs random-access iterators");
+    }
+
+    static size_t normalize_rotation(long long r, size_t n) {
+        long long m = static_cast<long long>(n);
+        return static_cast<size_t>(((r % m) + m) % m);
+    }
+
+    // Whether It walks real contiguous storage of T, so that &*it is a T*
+    // into an array. std::vector<bool> packs bits behind proxy iterators
+    // and is excluded.
+    template<typename It>
+    static constexpr bool is_contiguous() {
+#ifdef __cpp_lib_concepts
+        return std::contiguous_iterator<It>;
+#else
+        return std::is_pointer<It>::value
+               || (!std::is_same<T, bool>::value && std::is_same<It, typename std::vector<T>::iterator>::value);
+#endif
+    }
+
+    // Reverses first[start, end), with the vector kernel when the
+    // elements are contiguous.
+    template<typename It>
+    static void reverse_range(It first, size_t start, size_t end) {
+        if constexpr (is_contiguous<It>()) {
+            if (start < end) {
+                T* base = &*first;
+                reverse_swap(base + start, base + end);
+            }
+        } else {
+            while (start + 1 < end) {
+                --end;
+                std::iter_swap(first + start, first + end);
+                start++;
+            }
+        }
+    }
+
+    // Splits [0, pairs) into one run per thread and calls f(from, to) on
+    // each, the first run on the calling thread.
+    template<typename F>
+    static void parallel_pairs(size_t pairs, unsigned threads, F f) {
+        std::vector<std::thread> pool;
+        for (unsigned t = 1; t < threads; ++t) {
+            size_t from = pairs * t / threads, to = pairs * (t + 1) / threads;
+            if (from < to) {
+                pool.emplace_back(f, from, to);
+            }
+        }
+        f(0, pairs / threads);
+        for (auto& th : pool) th.join();
+    }
+
+    static size_t gcd(size_t a, size_t b) {
+        while (b != 0) {
+            size_t temp = b;
+            b = a % b;
+            a = temp;
+        }
+        return a;
+    }
+
+    // Right rotation by k along the gcd(n, k) cycles of i -> i + k.
+    template<typename It>
+    static void cyclic_rotate(It first, size_t n, size_t k) {
+        if (k == 0) return;
+        size_t g = gcd(n, k);
+        for (size_t start = 0; start < g; ++start) {
+            T temp = std::move(first[start]);
+            size_t current = start;
+            while (true) {
+                size_t prev = current >= k ? current - k : current + n - k;
+                if (prev == start) break;
+                first[current] = std::move(first[prev]);
+                current = prev;
+            }
+            first[current] = std::move(temp);
+        }
+    }
+
+    // Left rotation of first[0, n) by d, i.e. first[d, n) then first[0, d).
+    template<typename It>
+    static void block_swap_rotate(It first, size_t n, size_t d) {
+        if (d == 0 || d == n) return;
+        size_t i = d, j = n - d;
+        while (i != j) {
+            if (std::min(i, j) * sizeof(T) <= BUFFER_BYTES) {
+                buffer_rotate(first + (d - i), i + j, j);
+                return;
+            }
+            if (i < j) {
+                std::swap_ranges(first + (d - i), first + d, first + (d + j - i));
+                j -= i;
+            } else {
+                std::swap_ranges(first + (d - i), first + (d - i + j), first + d);
+                i -= j;
+            }
+        }
+        std::swap_ranges(first + (d - i), first + d, first + d);
+    }
+
+    // Right rotation by k that parks the shorter side in a buffer.
+    template<typename It>
+    static void buffer_rotate(It first, size_t n, size_t k) {
+        if (k <= n - k) {
+            std::vector<T> tail(std::make_move_iterator(first + (n - k)), std::make_move_iterator(first + n));
+            std::move_backward(first, first + (n - k), first + n);
+            std::move(tail.begin(), tail.end(), first);
+        } else {
+            std::vector<T> head(std::make_move_iterator(first), std::make_move_iterator(first + (n - k)));
+            std::move(first + (n - k), first + n, first);
+            std::move(head.begin(), head.end(), first + k);
+        }
+    }
+};
+
+/**
+ * A rotation that has not happened yet. The view records only the total
+ * shift, so any number of rotate() calls compose in O(1); reads go through
+ * the offset, and the elements move only when materialize() is called,
+ * once, with ArrayRotator::rotate. Index i of the view is element
+ * (i - offset) mod n of the buffer. The view refers to the caller's
+ * storage, which must not be resized while it is in use.
+ */
+template<typename T>
+class RotatedView {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_cv_t<T>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator() = default;
+        iterator(const RotatedView* view, size_t i) : view(view), i(i) {}
+
+        reference operator*() const { return (*view)[i]; }
+        pointer operator->() const { return &(*view)[i]; }
+        reference operator[](difference_type k) const { return (*view)[i + k]; }
+
+        iterator& operator++() { ++i; return *this; }
+        iterator operator++(int) { iterator old = *this; ++i; return old; }
+        iterator& operator--() { --i; return *this; }
+        iterator operator--(int) { iterator old = *this; --i; return old; }
+        iterator& operator+=(difference_type k) { i += k; return *this; }
+        iterator& operator-=(difference_type k) { i -= k; return *this; }
+        friend iterator operator+(iterator it, difference_type k) { return it += k; }
+        friend iterator operator+(difference_type k, iterator it) { return it += k; }
+        friend iterator operator-(iterator it, difference_type k) { return it -= k; }
+        friend difference_type operator-(const iterator& a, const iterator& b) {
+            return static_cast<difference_type>(a.i) - static_cast<difference_type>(b.i);
+        }
+
+        friend bool operator==(const iterator& a, const iterator& b) { return a.i == b.i; }
+        friend bool operator!=(const iterator& a, const iterator& b) { return a.i != b.i; }
+        friend bool operator<(const iterator& a, const iterator& b) { return a.i < b.i; }
+        friend bool operator>(const iterator& a, const iterator& b) { return a.i > b.i; }
+        friend bool operator<=(const iterator& a, const iterator& b) { return a.i <= b.i; }
+        friend bool operator>=(const iterator& a, const iterator& b) { return a.i >= b.i; }
+
+    private:
+        const RotatedView* view = nullptr;
+        size_t i = 0;
+    };
+
+    RotatedView(T* first, T* last) : base(first), n(static_cast<size_t>(last - first)) {}
+    explicit RotatedView(std::vector<T>& a) : RotatedView(a.data(), a.data() + a.size()) {}
+
+    // Composes a further right rotation by r.
+    void rotate(long long r) {
+        if (n == 0) return;
+        long long m = static_cast<long long>(n);
+        shift = (shift + static_cast<size_t>(((r % m) + m) % m)) % n;
+        start = shift == 0 ? 0 : n - shift;
+    }
+
+    T& operator[](size_t i) const {
+        size_t j = i + start;
+        return base[j >= n ? j - n : j];
+    }
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, n); }
+
+    // Calls f on every element in view order as two straight loops over
+    // the buffer, without the wrap-around check per element.
+    template<typename F>
+    void for_each(F f) const {
+        for (size_t j = start; j < n; ++j) f(base[j]);
+        for (size_t j = 0; j < start; ++j) f(base[j]);
     }
+
+    // Performs the pending rotation on the buffer; the view then has
+    // offset 0 and reads straight through.
+    void materialize() {
+        if (shift != 0) {
+            ArrayRotator<T>::rotate(base, base + n, static_cast<long long>(shift));
+        }
+        shift = start = 0;
+    }
+
+    size_t offset() const { return shift; }
+    size_t size() const { return n; }
+
+private:
+    T* base;
+    size_t n;
+    size_t shift = 0;   // pending right rotation
+    size_t start = 0;   // buffer index of view index 0
 };
 
 void test_edge_cases() {
@@ -102,6 +592,417 @@ void test_edge_cases() {
     std::cout << "\n";
 }
 
+// Every method against std::rotate, for all shifts of small arrays and a
+// few of larger ones, with a cheap and a heap-owning element type.
+template<typename T, typename Make>
+bool check_methods(size_t n, long long r, Make make) {
+    std::vector<T> original;
+    for (size_t i = 0; i < n; ++i) original.push_back(make(i));
+    std::vector<T> expected = original;
+    if (n > 0) {
+        long long m = static_cast<long long>(n);
+        size_t k = static_cast<size_t>(((r % m) + m) % m);
+        std::rotate(expected.begin(), expected.end() - k, expected.end());
+    }
+
+    using Method = void (*)(std::vector<T>&, long long);
+    Method methods[] = {
+        ArrayRotator<T>::rotate_simple, ArrayRotator<T>::rotate_reversal, ArrayRotator<T>::rotate_cyclic,
+        ArrayRotator<T>::rotate_block_swap, ArrayRotator<T>::rotate,
+    };
+    for (Method m : methods) {
+        std::vector<T> a = original;
+        m(a, r);
+        if (a != expected) return false;
+    }
+    return true;
+}
+
+void test_rotation_methods() {
+    std::cout << "\nTesting all methods against std::rotate...\n";
+    bool ok = true;
+    auto asInt = [](size_t i) { return static_cast<int>(i); };
+    auto asString = [](size_t i) { return std::string(20, static_cast<char>('a' + i % 26)) + std::to_string(i); };
+    for (size_t n = 0; n <= 24; ++n) {
+        for (long long r = -2 * static_cast<long long>(n) - 1; r <= 2 * static_cast<long long>(n) + 1; ++r) {
+            ok = ok && check_methods<int>(n, r, asInt) && check_methods<std::string>(n, r, asString);
+        }
+    }
+    // Sizes that reach every branch of rotate().
+    for (size_t n : {5000u, 70000u, 200000u}) {
+        for (long long r : {1LL, -3LL, 1000LL, static_cast<long long>(n / 2), static_cast<long long>(n / 3 + 1),
+                            static_cast<long long>(n / 4), static_cast<long long>(n) - 7}) {
+            ok = ok && check_methods<int>(n, r, asInt);
+        }
+    }
+    ok = ok && check_methods<std::string>(20000, 5003, asString);
+    // std::vector<bool> has proxy iterators rather than bool storage.
+    auto asBool = [](size_t i) { return i % 3 == 0; };
+    for (size_t n : {0u, 1u, 7u, 64u, 1000u}) {
+        for (long long r : {1LL, -2LL, 5LL, 333LL}) {
+            ok = ok && check_methods<bool>(n, r, asBool);
+        }
+    }
+    std::cout << "All methods agree with std::rotate: " << (ok ? "PASSED" : "FAILED") << "\n";
+}
+
+template<typename F>
+long long time_ms(F f) {
+    auto start = std::chrono::high_resolution_clock::now();
+    f();
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+}
+
+void bench_rotate() {
+    const size_t n = 10000000;
+    std::cout << "\nRotating " << n << " ints (ms)...\n";
+    std::vector<int> a(n);
+    for (size_t i = 0; i < n; ++i) a[i] = static_cast<int>(i);
+
+    std::cout << std::setw(10) << "shift" << std::setw(10) << "reversal" << std::setw(10) << "cyclic"
+              << std::setw(12) << "block_swap" << std::setw(10) << "rotate" << std::setw(13) << "std::rotate" << "\n";
+    for (size_t r : {size_t(1), size_t(1000), n / 2, n / 3 + 1, n / 4, n - 1}) {
+        std::cout << std::setw(10) << r
+                  << std::setw(10) << time_ms([&] { ArrayRotator<int>::rotate_reversal(a, r); })
+                  << std::setw(10) << time_ms([&] { ArrayRotator<int>::rotate_cyclic(a, r); })
+                  << std::setw(12) << time_ms([&] { ArrayRotator<int>::rotate_block_swap(a, r); })
+                  << std::setw(10) << time_ms([&] { ArrayRotator<int>::rotate(a, r); })
+                  << std::setw(13) << time_ms([&] { std::rotate(a.begin(), a.end() - r, a.end()); }) << "\n";
+    }
+}
+
+template<typename T>
+bool check_reverse_swap() {
+    for (size_t offset = 0; offset < 3; ++offset) {
+        for (size_t n = 0; n <= 200; ++n) {
+            std::vector<T> a(n + offset);
+            for (size_t i = 0; i < a.size(); ++i) a[i] = static_cast<T>(i * 37 + 11);
+            std::vector<T> expected = a;
+            std::reverse(expected.begin() + offset, expected.end());
+            reverse_swap(a.data() + offset, a.data() + a.size());
+            if (a != expected) return false;
+        }
+    }
+    return true;
+}
+
+void test_reverse_swap() {
+    std::cout << "\nTesting reverse_swap (" << ARRAY_ROTATOR_SIMD_BYTES << "-byte vectors)...\n";
+    bool ok = check_reverse_swap<unsigned char>() && check_reverse_swap<short>() && check_reverse_swap<int>()
+              && check_reverse_swap<long long>() && check_reverse_swap<double>() && check_reverse_swap<float>();
+    std::cout << "Matches std::reverse for 1, 2, 4 and 8-byte types: " << (ok ? "PASSED" : "FAILED") << "\n";
+}
+
+void bench_reverse() {
+    const size_t n = size_t(1) << 25;
+    std::cout << "\nReversing " << n << " ints...\n";
+    std::vector<int> a(n);
+    for (size_t i = 0; i < n; ++i) a[i] = static_cast<int>(i);
+    double gb = 2.0 * n * sizeof(int) / 1e9;   // every byte read and written once
+
+    auto report = [&](const char* name, long long ms) {
+        std::cout << std::setw(24) << name << ": " << std::setw(5) << ms << " ms, "
+                  << (ms > 0 ? gb / (ms / 1000.0) : 0.0) << " GB/s\n";
+    };
+    report("one swap at a time", time_ms([&] {
+        for (size_t i = 0, j = n - 1; i < j; ++i, --j) std::swap(a[i], a[j]);
+    }));
+    report("std::reverse", time_ms([&] { std::reverse(a.begin(), a.end()); }));
+    report("reverse_swap", time_ms([&] { reverse_swap(a.data(), a.data() + n); }));
+    report("rotate_reversal (x2)", time_ms([&] { ArrayRotator<int>::rotate_reversal(a, n / 3); }));
+    std::vector<int> copy(n, 1);
+    report("copy (bandwidth bound)", time_ms([&] { std::copy(a.begin(), a.end(), copy.begin()); }));
+}
+
+void test_rotate_parallel() {
+    std::cout << "\nTesting rotate_parallel...\n";
+    bool ok = true;
+    for (size_t n : {size_t(300000), size_t(300001), size_t(1) << 19}) {
+        std::vector<int> original(n);
+        for (size_t i = 0; i < n; ++i) original[i] = static_cast<int>(i);
+        for (unsigned threads : {2u, 3u, 4u, 7u}) {
+            for (long long r : {1LL, 2LL, 12345LL, static_cast<long long>(n / 2), -static_cast<long long>(n / 3)}) {
+                std::vector<int> a = original, expected = original;
+                long long m = static_cast<long long>(n);
+                size_t k = static_cast<size_t>(((r % m) + m) % m);
+                std::rotate(expected.begin(), expected.end() - k, expected.end());
+                ArrayRotator<int>::rotate_parallel(a, r, threads);
+                ok = ok && a == expected;
+            }
+        }
+    }
+    std::vector<std::string> words(100000);
+    for (size_t i = 0; i < words.size(); ++i) words[i] = std::to_string(i);
+    std::vector<std::string> expected = words;
+    std::rotate(expected.begin(), expected.end() - 777, expected.end());
+    ArrayRotator<std::string>::rotate_parallel(words, 777, 4);
+    ok = ok && words == expected;
+    std::cout << "rotate_parallel agrees with std::rotate: " << (ok ? "PASSED" : "FAILED") << "\n";
+}
+
+void bench_rotate_parallel() {
+    const size_t n = size_t(1) << 26;
+    std::cout << "\nRotating " << n << " ints by n/3 (" << std::thread::hardware_concurrency()
+              << " hardware threads)...\n";
+    std::vector<int> a(n);
+    for (size_t i = 0; i < n; ++i) a[i] = static_cast<int>(i);
+    long long r = static_cast<long long>(n / 3);
+
+    std::cout << std::setw(22) << "std::rotate: " << time_ms([&] { std::rotate(a.begin(), a.end() - r, a.end()); })
+              << " ms\n";
+    std::cout << std::setw(22) << "rotate_reversal: " << time_ms([&] { ArrayRotator<int>::rotate_reversal(a, r); })
+              << " ms\n";
+    for (unsigned threads : {1u, 2u, 4u, 8u, 16u}) {
+        std::cout << std::setw(12) << "parallel, " << std::setw(2) << threads << " threads: "
+                  << time_ms([&] { ArrayRotator<int>::rotate_parallel(a, r, threads); }) << " ms\n";
+    }
+}
+
+void test_views() {
+    std::cout << "\nTesting iterator, span and strided overloads...\n";
+
+    // Sub-range through iterators and raw pointers.
+    std::vector<int> a = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    ArrayRotator<int>::rotate(a.begin() + 2, a.begin() + 7, 2);
+    ArrayRotator<int>::rotate_reversal(a.data() + 7, a.data() + 10, -1);
+    bool ok = a == std::vector<int>{0, 1, 5, 6, 2, 3, 4, 8, 9, 7};
+
+    // Rotate column 1 of a 4x3 row-major matrix down by one, then row 2
+    // right by one, without copying either out.
+    const size_t rows = 4, cols = 3;
+    std::vector<int> m(rows * cols);
+    for (size_t i = 0; i < m.size(); ++i) m[i] = static_cast<int>(i);
+    StridedView<int> column(m.data() + 1, rows, static_cast<std::ptrdiff_t>(cols));
+    ArrayRotator<int>::rotate_cyclic(column.begin(), column.end(), 1);
+    ArrayRotator<int>::rotate_block_swap(m.begin() + 2 * cols, m.begin() + 3 * cols, 1);
+    ok = ok && m == std::vector<int>{0, 10, 2, 3, 1, 5, 8, 6, 4, 9, 7, 11};
+
+    // Every method on a strided view agrees with rotating a copy.
+    std::vector<int> big(3000);
+    for (size_t i = 0; i < big.size(); ++i) big[i] = static_cast<int>(i);
+    using Method = void (*)(StridedView<int>::iterator, StridedView<int>::iterator, long long);
+    Method methods[] = {
+        ArrayRotator<int>::rotate_simple<StridedView<int>::iterator>,
+        ArrayRotator<int>::rotate_reversal<StridedView<int>::iterator>,
+        ArrayRotator<int>::rotate_cyclic<StridedView<int>::iterator>,
+        ArrayRotator<int>::rotate_block_swap<StridedView<int>::iterator>,
+        ArrayRotator<int>::rotate<StridedView<int>::iterator>,
+    };
+    for (Method method : methods) {
+        for (long long r : {1LL, 7LL, 500LL, -333LL}) {
+            std::vector<int> b = big;
+            StridedView<int> odd(b.data() + 1, b.size() / 2, 2);
+            std::vector<int> expected(odd.begin(), odd.end());
+            ArrayRotator<int>::rotate(expected, r);
+            method(odd.begin(), odd.end(), r);
+            ok = ok && std::equal(expected.begin(), expected.end(), odd.begin());
+            for (size_t i = 0; i < b.size(); i += 2) ok = ok && b[i] == big[i];
+        }
+    }
+
+    // Walking backwards with a negative stride rotates the other way.
+    std::vector<int> c = {0, 1, 2, 3, 4};
+    StridedView<int> backwards(c.data() + 4, c.size(), -1);
+    ArrayRotator<int>::rotate(backwards.begin(), backwards.end(), 1);
+    ok = ok && c == std::vector<int>{1, 2, 3, 4, 0};
+
+#ifdef __cpp_lib_span
+    std::vector<int> d = {0, 1, 2, 3, 4, 5};
+    ArrayRotator<int>::rotate(std::span<int>(d).subspan(1, 4), 1);
+    ok = ok && d == std::vector<int>{0, 4, 1, 2, 3, 5};
+    std::cout << "(std::span overloads included)\n";
+#endif
+    std::cout << "Sub-ranges, matrix rows and columns rotate in place: " << (ok ? "PASSED" : "FAILED") << "\n";
+}
+
+void test_rotated_view() {
+    std::cout << "\nTesting RotatedView...\n";
+
+    std::vector<int> a(1000);
+    for (size_t i = 0; i < a.size(); ++i) a[i] = static_cast<int>(i);
+    std::vector<int> expected = a;
+    RotatedView<int> view(a);
+    bool ok = true;
+    for (long long r : {3LL, -10LL, 997LL, 5000LL, 0LL, -1LL}) {
+        view.rotate(r);
+        ArrayRotator<int>::rotate(expected, r);
+        ok = ok && std::equal(expected.begin(), expected.end(), view.begin()) && view[17] == expected[17];
+    }
+    std::vector<int> visited;
+    view.for_each([&](int x) { visited.push_back(x); });
+    ok = ok && visited == expected && view.end() - view.begin() == 1000;
+    std::cout << "Reads follow the composed offset " << view.offset() << ": " << (ok ? "PASSED" : "FAILED") << "\n";
+
+    std::vector<int> untouched(1000);
+    for (size_t i = 0; i < untouched.size(); ++i) untouched[i] = static_cast<int>(i);
+    bool lazy = a == untouched;
+    view[0] = -1;
+    expected[0] = -1;
+    view.materialize();
+    std::cout << "Buffer moves only on materialize(): "
+              << (lazy && a == expected && view.offset() == 0 && view[0] == -1 ? "PASSED" : "FAILED") << "\n";
+}
+
+void bench_rotated_view() {
+    const size_t n = 1000000;
+    const int rotations = 100;
+    std::cout << "\n" << rotations << " rotations of " << n << " ints, then one read...\n";
+    std::vector<int> a(n), b(n);
+    for (size_t i = 0; i < n; ++i) a[i] = b[i] = static_cast<int>(i);
+    std::mt19937 rng(1);
+    std::vector<long long> shifts(rotations);
+    for (long long& r : shifts) r = static_cast<long long>(rng() % n);
+
+    long long sumA = 0, sumB = 0;
+    long long eager = time_ms([&] {
+        for (long long r : shifts) ArrayRotator<int>::rotate(a, r);
+        for (size_t i = 0; i < n; ++i) sumA += a[i] * static_cast<long long>(i & 7);
+    });
+    long long lazy = time_ms([&] {
+        RotatedView<int> view(b);
+        for (long long r : shifts) view.rotate(r);
+        size_t i = 0;
+        view.for_each([&](int x) { sumB += x * static_cast<long long>(i++ & 7); });
+    });
+    std::cout << "rotate each time: " << eager << " ms, RotatedView: " << lazy << " ms"
+              << (sumA == sumB ? "" : " (MISMATCH)") << "\n";
+}
+
+// Element types for the benchmark suite.
+struct Pod64 {
+    long long words[8];
+};
+
+// Wraps T and counts element stores in rotation_writes, which is how the
+// suite measures bytes moved. A move or copy, constructed or assigned, is
+// one store; a swap is two, as in the vector kernel, which writes both
+// ends of each pair and keeps nothing else in memory. Counted<T> is never
+// trivially copyable, so it goes through the scalar loops, but they store
+// the same elements as the kernel that the timed T runs. The exception is
+// std::rotate, which libstdc++ turns into one memmove for trivial types
+// shifted by one; its row then counts the generic algorithm. Treated like
+// T by rotate()'s method selection.
+inline long long rotation_writes = 0;
+
+template<typename T>
+struct Counted {
+    T value;
+
+    Counted() = default;
+    explicit Counted(T v) : value(std::move(v)) {}
+    Counted(const Counted& o) : value(o.value) { ++rotation_writes; }
+    Counted(Counted&& o) noexcept : value(std::move(o.value)) { ++rotation_writes; }
+    Counted& operator=(const Counted& o) { value = o.value; ++rotation_writes; return *this; }
+    Counted& operator=(Counted&& o) noexcept { value = std::move(o.value); ++rotation_writes; return *this; }
+
+    friend void swap(Counted& a, Counted& b) noexcept {
+        using std::swap;
+        swap(a.value, b.value);
+        rotation_writes += 2;
+    }
+};
+
+template<typename T>
+struct cheap_to_move<Counted<T>> : cheap_to_move<T> {};
+
+template<typename T>
+T make_element(size_t i) {
+    if constexpr (std::is_same<T, std::string>::value) {
+        return "element number " + std::to_string(i);   // long enough to live on the heap
+    } else if constexpr (std::is_same<T, Pod64>::value) {
+        Pod64 p{};
+        p.words[0] = static_cast<long long>(i);
+        return p;
+    } else {
+        return static_cast<T>(i);
+    }
+}
+
+// One row per method for the given type, n and shift: nanoseconds per
+// element (best of a few runs for small n) and bytes written per element,
+// i.e. element stores counted through Counted<T> times sizeof(T).
+template<typename T>
+void bench_suite_case(const char* typeName, size_t n, const char* shiftName, size_t r) {
+    std::vector<T> a(n);
+    for (size_t i = 0; i < n; ++i) a[i] = make_element<T>(i);
+    std::vector<Counted<T>> counted;
+    counted.reserve(n);
+    for (size_t i = 0; i < n; ++i) counted.emplace_back(make_element<T>(i));
+
+    using Method = void (*)(std::vector<T>&, long long);
+    using CountedMethod = void (*)(std::vector<Counted<T>>&, long long);
+    struct Row {
+        const char* name;
+        Method run;
+        CountedMethod count;
+    };
+    Row rows[] = {
+        {"simple", ArrayRotator<T>::rotate_simple, ArrayRotator<Counted<T>>::rotate_simple},
+        {"reversal", ArrayRotator<T>::rotate_reversal, ArrayRotator<Counted<T>>::rotate_reversal},
+        {"cyclic", ArrayRotator<T>::rotate_cyclic, ArrayRotator<Counted<T>>::rotate_cyclic},
+        {"block_swap", ArrayRotator<T>::rotate_block_swap, ArrayRotator<Counted<T>>::rotate_block_swap},
+        {"rotate", ArrayRotator<T>::rotate, ArrayRotator<Counted<T>>::rotate},
+        {"std::rotate",
+         [](std::vector<T>& v, long long k) { std::rotate(v.begin(), v.end() - k, v.end()); },
+         [](std::vector<Counted<T>>& v, long long k) { std::rotate(v.begin(), v.end() - k, v.end()); }},
+    };
+
+    int reps = static_cast<int>(std::max<size_t>(1, std::min<size_t>(20, 10000000 / n)));
+    for (const Row& row : rows) {
+        double best = 1e300;
+        for (int rep = 0; rep < reps; ++rep) {
+            auto start = std::chrono::high_resolution_clock::now();
+            row.run(a, static_cast<long long>(r));
+            auto end = std::chrono::high_resolution_clock::now();
+            best = std::min(best, std::chrono::duration<double, std::nano>(end - start).count());
+        }
+        rotation_writes = 0;
+        row.count(counted, static_cast<long long>(r));
+        double bytes = static_cast<double>(rotation_writes) * sizeof(T) / n;
+
+        std::cout << std::setw(12) << typeName << std::setw(11) << n << std::setw(10) << shiftName
+                  << std::setw(11) << r << std::setw(13) << row.name
+                  << std::setw(10) << std::fixed << std::setprecision(2) << best / n
+                  << std::setw(12) << std::setprecision(1) << bytes << "\n";
+        std::cout.unsetf(std::ios::floatfield);
+    }
+}
+
+// Shift classes: small (1), large (n - 1, i.e. a left rotation by one),
+// coprime with n (about n / 3, one gcd cycle) and gcd-heavy (n / 4 for
+// n divisible by 4, n / 4 cycles). Arrays beyond maxBytes are skipped.
+template<typename T>
+void bench_suite_type(const char* typeName, size_t maxN, size_t maxBytes) {
+    for (size_t n = 1000; n <= maxN; n *= 10) {
+        if (n * sizeof(T) > maxBytes) {
+            std::cout << std::setw(12) << typeName << std::setw(11) << n << "  skipped (over "
+                      << maxBytes / (1 << 20) << " MB)\n";
+            continue;
+        }
+        size_t coprime = n / 3;
+        while (std::gcd(n, coprime) != 1) ++coprime;
+        bench_suite_case<T>(typeName, n, "small", 1);
+        bench_suite_case<T>(typeName, n, "large", n - 1);
+        bench_suite_case<T>(typeName, n, "coprime", coprime);
+        bench_suite_case<T>(typeName, n, "gcd-heavy", n / 4);
+    }
+}
+
+// Runs n = 1e3 .. 1e5 by default; with full, up to 1e8 elements where the
+// array stays under 1 GB.
+void bench_suite(bool full) {
+    size_t maxN = full ? 100000000 : 100000;
+    size_t maxBytes = size_t(1) << 30;
+    std::cout << "\nRotation benchmark suite" << (full ? "" : " (pass --full for n up to 1e8)") << "\n";
+    std::cout << std::setw(12) << "type" << std::setw(11) << "n" << std::setw(10) << "shift"
+              << std::setw(11) << "r" << std::setw(13) << "method"
+              << std::setw(10) << "ns/elem" << std::setw(12) << "bytes/elem" << "\n";
+    bench_suite_type<int>("int", maxN, maxBytes);
+    bench_suite_type<Pod64>("Pod64", maxN, maxBytes);
+    bench_suite_type<std::string>("std::string", std::min<size_t>(maxN, 10000000), maxBytes);
+}
+
 // Main test function
 void test_rotate() {
     std::cout << "Testing Array Rotation...\n";
@@ -137,9 +1038,20 @@ void test_rotate() {
     }
 
     test_edge_cases();
+    test_rotation_methods();
+    test_reverse_swap();
+    test_rotate_parallel();
+    test_views();
+    test_rotated_view();
 }
 
-int main() {
+int main(int argc, char** argv) {
+    bool full = argc > 1 && std::string(argv[1]) == "--full";
     test_rotate();
+    bench_rotate();
+    bench_reverse();
+    bench_rotate_parallel();
+    bench_rotated_view();
+    bench_suite(full);
     return 0;
 }
@@ -1,6 +1,17 @@
 #include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
 #include <vector>
+#if __has_include(<version>)
+#include <version>
+#endif
 #include <iostream>
+#include <sstream>
+#include <string>
 using namespace std;
 
 template<typename T>
@@ -15,9 +26,10 @@ private:
   void resize(int new_capacity) {
     vector<T> new_data(new_capacity);
 
-for (int i = 0; i < n; ++n){
-      new_data[i] = data[(head + i) % capacity];
-    }
+    // The live elements are at most two contiguous runs of the ring.
+    int first = min(n, capacity - head);
+    move(data.begin() + head, data.begin() + head + first, new_data.begin());
+    move(data.begin(), data.begin() + (n - first), new_data.begin() + first);
     data = std::move(new_data);
     head = 0;
     tail = n;
@@ -25,6 +37,39 @@ for (int i = 0; i < n; ++n){
 
   }
 
+    // True when It points into contiguous storage of exactly T, so a run
+    // of it can be memcpy'd to or from the ring.
+    template<typename It>
+    static constexpr bool is_contiguous() {
+        if constexpr (!is_same<remove_cv_t<typename iterator_traits<It>::value_type>, T>::value) {
+            return false;
+        } else {
+#ifdef __cpp_lib_concepts
+            return std::contiguous_iterator<It>;
+#else
+            return is_pointer<It>::value
+                   || (!is_same<T, bool>::value && (is_same<It, typename vector<T>::iterator>::value
+                                                   || is_same<It, typename vector<T>::const_iterator>::value));
+#endif
+        }
+    }
+
+    // Copies (or, with Move, moves) count elements from src to dst, with
+    // memcpy when both sides are contiguous and T is trivially copyable.
+    template<bool Move = false, typename In, typename Out>
+    static Out copy_run(In src, int count, Out dst) {
+        if constexpr (is_trivially_copyable<T>::value && is_contiguous<In>() && is_contiguous<Out>()) {
+            if (count > 0) {
+                memcpy(&*dst, &*src, count * sizeof(T));
+            }
+            return dst + count;
+        } else if constexpr (Move) {
+            return move(src, next(src, count), dst);
+        } else {
+            return copy_n(src, count, dst);
+        }
+    }
+
 public:
     ArrayQueue(int cap = 10) : data(cap), head(0), tail(0), n(0), capacity(cap) {}
     
@@ -44,6 +89,44 @@ public:
         return rHead;
     }
     
+    // Appends [first, last) with at most two block copies, one up to the
+    // end of the array and one wrapping to the front, and a single update
+    // of tail and n. Grows once if the batch does not fit. A single-pass
+    // input range cannot be measured and then read, so it is collected
+    // into a buffer first.
+    template<typename It>
+    void add_n(It first, It last) {
+        if constexpr (!is_base_of<forward_iterator_tag, typename iterator_traits<It>::iterator_category>::value) {
+            vector<T> buffer(first, last);
+            add_n(make_move_iterator(buffer.begin()), make_move_iterator(buffer.end()));
+            return;
+        } else {
+            int k = static_cast<int>(distance(first, last));
+            if (k == 0) return;
+            if (n + k > capacity) resize(max(capacity * 2, n + k));
+            int run = min(k, capacity - tail);
+            copy_run(first, run, data.begin() + tail);
+            copy_run(next(first, run), k - run, data.begin());
+            tail += k;
+            if (tail >= capacity) tail -= capacity;
+            n += k;
+        }
+    }
+
+    // Moves the first k elements into out, in queue order, the same way;
+    // returns the output iterator past the last element written.
+    template<typename Out>
+    Out remove_n(Out out, int k) {
+        if (k < 0 || k > n) throw runtime_error("Not enough elements in queue");
+        int run = min(k, capacity - head);
+        out = copy_run<true>(data.begin() + head, run, out);
+        out = copy_run<true>(data.begin(), k - run, out);
+        head += k;
+        if (head >= capacity) head -= capacity;
+        n -= k;
+        return out;
+    }
+
    void rotate(int r) {
     if (n == 0) return;
     r = ((r % n) + n) % n;    
@@ -218,9 +301,147 @@ void test_performance() {
     cout << "Performance test completed\n";
 }
 
+// Counts copies so the batch tests can tell a move from a copy.
+struct CopyCounter {
+    static int copies;
+    int value = 0;
+    CopyCounter() = default;
+    explicit CopyCounter(int v) : value(v) {}
+    CopyCounter(const CopyCounter& other) : value(other.value) { ++copies; }
+    CopyCounter(CopyCounter&&) = default;
+    CopyCounter& operator=(const CopyCounter& other) { value = other.value; ++copies; return *this; }
+    CopyCounter& operator=(CopyCounter&&) = default;
+};
+int CopyCounter::copies = 0;
+
+void test_batch_operations() {
+    cout << "\n=== Testing ArrayQueue add_n/remove_n ===\n";
+
+    // Mixed batch sizes against std::deque, so batches land on every
+    // combination of wrapped and unwrapped runs and cross a few resizes.
+    ArrayQueue<int> q(4);
+    deque<int> reference;
+    int nextValue = 0;
+    bool ok = true;
+    for (int round = 0; round < 200; ++round) {
+        int addCount = (round * 7) % 13;
+        vector<int> batch(addCount);
+        for (int& x : batch) x = nextValue++;
+        q.add_n(batch.begin(), batch.end());
+        reference.insert(reference.end(), batch.begin(), batch.end());
+
+        int removeCount = min<int>((round * 5) % 11, q.size());
+        vector<int> out(removeCount);
+        auto end = q.remove_n(out.data(), removeCount);
+        ok = ok && end == out.data() + removeCount;
+        for (int x : out) {
+            ok = ok && x == reference.front();
+            reference.pop_front();
+        }
+        if (round % 3 == 0 && !q.empty()) {
+            q.add(nextValue);
+            reference.push_back(nextValue++);
+            ok = ok && q.remove() == reference.front();
+            reference.pop_front();
+        }
+        ok = ok && q.size() == static_cast<int>(reference.size());
+    }
+    for (int i = 0; i < q.size(); ++i) {
+        ok = ok && q.get(i) == reference[i];
+    }
+    cout << "Matches std::deque: " << (ok ? "PASSED" : "FAILED") << "\n";
+
+    // Non-contiguous source and destination take the element-wise path.
+    ArrayQueue<string> words(2);
+    deque<string> source = {"a", "b", "c", "d", "e"};
+    words.add_n(source.begin(), source.end());
+    vector<string> drained;
+    words.remove_n(back_inserter(drained), 3);
+    cout << "Non-trivial types and iterators: "
+         << (drained == vector<string>{"a", "b", "c"} && words.size() == 2 && words.get(0) == "d" ? "PASSED" : "FAILED")
+         << "\n";
+
+    // Drained elements are moved out, not copied.
+    ArrayQueue<CopyCounter> counted(4);
+    for (int i = 0; i < 3; ++i) counted.add(CopyCounter{i});
+    vector<CopyCounter> taken(2);
+    CopyCounter::copies = 0;
+    counted.remove_n(taken.begin(), 2);
+    cout << "remove_n moves elements out: "
+         << (CopyCounter::copies == 0 && taken[1].value == 1 && counted.size() == 1 ? "PASSED" : "FAILED") << "\n";
+
+    // Single-pass input iterators are read exactly once.
+    istringstream numbers("1 2 3 4 5 6 7");
+    ArrayQueue<int> fromStream(3);
+    fromStream.add_n(istream_iterator<int>(numbers), istream_iterator<int>());
+    vector<int> streamed(7);
+    fromStream.remove_n(streamed.begin(), 7);
+    cout << "add_n from an input iterator: "
+         << (streamed == vector<int>{1, 2, 3, 4, 5, 6, 7} && fromStream.empty() ? "PASSED" : "FAILED") << "\n";
+
+    // Pointers to a different element type convert element by element.
+    int narrow[3] = {1, -2, 3};
+    ArrayQueue<long long> wide(2);
+    wide.add_n(narrow, narrow + 3);
+    double converted[3];
+    ArrayQueue<int> ints(2);
+    ints.add_n(narrow, narrow + 3);
+    ints.remove_n(converted, 3);
+    cout << "Mismatched pointer types: "
+         << (wide.get(0) == 1 && wide.get(1) == -2 && wide.get(2) == 3
+             && converted[0] == 1.0 && converted[1] == -2.0 && converted[2] == 3.0 ? "PASSED" : "FAILED") << "\n";
+
+    // vector<bool> has no contiguous storage to copy from.
+    ArrayQueue<bool> flags(2);
+    vector<bool> bits = {true, false, true, true, false};
+    flags.add_n(bits.begin(), bits.end());
+    vector<bool> bitsOut(5);
+    flags.remove_n(bitsOut.begin(), 5);
+    cout << "ArrayQueue<bool>: " << (bitsOut == bits && flags.empty() ? "PASSED" : "FAILED") << "\n";
+
+    try {
+        words.remove_n(back_inserter(drained), 3);
+    } catch (const exception& e) {
+        cout << "Expected exception: " << e.what() << "\n";
+    }
+}
+
+void bench_batches() {
+    const int total = 10000000;
+    const int batch = 64;
+    cout << "\n=== Moving " << total << " ints through a queue in batches of " << batch << " ===\n";
+
+    vector<int> in(batch), out(batch);
+    for (int i = 0; i < batch; ++i) in[i] = i;
+    long long sum = 0;
+
+    ArrayQueue<int> single(1000);
+    auto start = chrono::high_resolution_clock::now();
+    for (int done = 0; done < total; done += batch) {
+        for (int x : in) single.add(x);
+        for (int i = 0; i < batch; ++i) out[i] = single.remove();
+        sum += out[batch - 1];
+    }
+    auto end = chrono::high_resolution_clock::now();
+    cout << "add/remove: " << chrono::duration_cast<chrono::milliseconds>(end - start).count() << " ms\n";
+
+    ArrayQueue<int> batched(1000);
+    start = chrono::high_resolution_clock::now();
+    for (int done = 0; done < total; done += batch) {
+        batched.add_n(in.begin(), in.end());
+        batched.remove_n(out.begin(), batch);
+        sum -= out[batch - 1];
+    }
+    end = chrono::high_resolution_clock::now();
+    cout << "add_n/remove_n: " << chrono::duration_cast<chrono::milliseconds>(end - start).count() << " ms"
+         << (sum == 0 ? "" : " (MISMATCH)") << "\n";
+}
+
 int main() {
     test_array_queue();
     test_dual_array_queue();
     test_performance();
+    test_batch_operations();
+    bench_batches();
     return 0;
 }